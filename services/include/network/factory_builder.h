@@ -25,6 +25,26 @@
 #include <network/youtube_video_snapshot_request.h>
 #include <network/youtube_video_snapshot_response.h>
 #include <network/youtube_video_updates.h>
+#include <network/network_message_view.h>
+#include <network/reply_view.h>
+#include <network/request_view.h>
+#include <network/test_reply_view.h>
+#include <network/test_request_view.h>
+#include <network/youtube_blog_view.h>
+#include <network/youtube_blog_heartbeat_view.h>
+#include <network/youtube_blog_snapshot_request_view.h>
+#include <network/youtube_blog_snapshot_response_view.h>
+#include <network/youtube_blog_updates_view.h>
+#include <network/youtube_resource_view.h>
+#include <network/youtube_resource_heartbeat_view.h>
+#include <network/youtube_resource_snapshot_request_view.h>
+#include <network/youtube_resource_snapshot_response_view.h>
+#include <network/youtube_resource_updates_view.h>
+#include <network/youtube_video_view.h>
+#include <network/youtube_video_heartbeat_view.h>
+#include <network/youtube_video_snapshot_request_view.h>
+#include <network/youtube_video_snapshot_response_view.h>
+#include <network/youtube_video_updates_view.h>
 
 namespace curious::net {
 
@@ -153,214 +173,42 @@ public:
     }
   }
 
-  static void toCapnp(capnp::MallocMessageBuilder& builder, const std::shared_ptr<network_message>& msg) {
-    if (!msg) {
-      throw std::runtime_error("Cannot serialize null message");
+  static std::shared_ptr<message_view> createView(std::shared_ptr<capnp::MessageReader> reader) {
+    auto msgType = curious::net::fromCapnp(reader->getRoot<curious::message::NetworkMessage>());
+    switch (msgType) {
+      case message_type::networkMessage: return std::make_shared<network_message_view>(std::move(reader));
+      case message_type::reply: return std::make_shared<reply_view>(std::move(reader));
+      case message_type::request: return std::make_shared<request_view>(std::move(reader));
+      case message_type::testReply: return std::make_shared<test_reply_view>(std::move(reader));
+      case message_type::testRequest: return std::make_shared<test_request_view>(std::move(reader));
+      case message_type::youtubeBlog: return std::make_shared<youtube_blog_view>(std::move(reader));
+      case message_type::youtubeBlogHeartbeat: return std::make_shared<youtube_blog_heartbeat_view>(std::move(reader));
+      case message_type::youtubeBlogSnapshotRequest: return std::make_shared<youtube_blog_snapshot_request_view>(std::move(reader));
+      case message_type::youtubeBlogSnapshotResponse: return std::make_shared<youtube_blog_snapshot_response_view>(std::move(reader));
+      case message_type::youtubeBlogUpdates: return std::make_shared<youtube_blog_updates_view>(std::move(reader));
+      case message_type::youtubeResource: return std::make_shared<youtube_resource_view>(std::move(reader));
+      case message_type::youtubeResourceHeartbeat: return std::make_shared<youtube_resource_heartbeat_view>(std::move(reader));
+      case message_type::youtubeResourceSnapshotRequest: return std::make_shared<youtube_resource_snapshot_request_view>(std::move(reader));
+      case message_type::youtubeResourceSnapshotResponse: return std::make_shared<youtube_resource_snapshot_response_view>(std::move(reader));
+      case message_type::youtubeResourceUpdates: return std::make_shared<youtube_resource_updates_view>(std::move(reader));
+      case message_type::youtubeVideo: return std::make_shared<youtube_video_view>(std::move(reader));
+      case message_type::youtubeVideoHeartbeat: return std::make_shared<youtube_video_heartbeat_view>(std::move(reader));
+      case message_type::youtubeVideoSnapshotRequest: return std::make_shared<youtube_video_snapshot_request_view>(std::move(reader));
+      case message_type::youtubeVideoSnapshotResponse: return std::make_shared<youtube_video_snapshot_response_view>(std::move(reader));
+      case message_type::youtubeVideoUpdates: return std::make_shared<youtube_video_updates_view>(std::move(reader));
+      default: return nullptr; // Unknown message type
     }
+  }
 
-    switch (msg->getMsgType()) {
-      case message_type::networkMessage: {
-        auto root = builder.initRoot<curious::message::NetworkMessage>();
-        auto typedMsg = std::dynamic_pointer_cast<network_message>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type network_message");
-        }
-        break;
-      }
-      case message_type::reply: {
-        auto root = builder.initRoot<curious::message::Reply>();
-        auto typedMsg = std::dynamic_pointer_cast<reply>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type reply");
-        }
-        break;
-      }
-      case message_type::request: {
-        auto root = builder.initRoot<curious::message::Request>();
-        auto typedMsg = std::dynamic_pointer_cast<request>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type request");
-        }
-        break;
-      }
-      case message_type::testReply: {
-        auto root = builder.initRoot<curious::message::TestReply>();
-        auto typedMsg = std::dynamic_pointer_cast<test_reply>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type test_reply");
-        }
-        break;
-      }
-      case message_type::testRequest: {
-        auto root = builder.initRoot<curious::message::TestRequest>();
-        auto typedMsg = std::dynamic_pointer_cast<test_request>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type test_request");
-        }
-        break;
-      }
-      case message_type::youtubeBlog: {
-        auto root = builder.initRoot<curious::message::YoutubeBlog>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_blog>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_blog");
-        }
-        break;
-      }
-      case message_type::youtubeBlogHeartbeat: {
-        auto root = builder.initRoot<curious::message::YoutubeBlogHeartbeat>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_blog_heartbeat>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_blog_heartbeat");
-        }
-        break;
-      }
-      case message_type::youtubeBlogSnapshotRequest: {
-        auto root = builder.initRoot<curious::message::YoutubeBlogSnapshotRequest>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_blog_snapshot_request>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_blog_snapshot_request");
-        }
-        break;
-      }
-      case message_type::youtubeBlogSnapshotResponse: {
-        auto root = builder.initRoot<curious::message::YoutubeBlogSnapshotResponse>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_blog_snapshot_response>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_blog_snapshot_response");
-        }
-        break;
-      }
-      case message_type::youtubeBlogUpdates: {
-        auto root = builder.initRoot<curious::message::YoutubeBlogUpdates>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_blog_updates>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_blog_updates");
-        }
-        break;
-      }
-      case message_type::youtubeResource: {
-        auto root = builder.initRoot<curious::message::YoutubeResource>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_resource>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_resource");
-        }
-        break;
-      }
-      case message_type::youtubeResourceHeartbeat: {
-        auto root = builder.initRoot<curious::message::YoutubeResourceHeartbeat>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_resource_heartbeat>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_resource_heartbeat");
-        }
-        break;
-      }
-      case message_type::youtubeResourceSnapshotRequest: {
-        auto root = builder.initRoot<curious::message::YoutubeResourceSnapshotRequest>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_resource_snapshot_request>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_resource_snapshot_request");
-        }
-        break;
-      }
-      case message_type::youtubeResourceSnapshotResponse: {
-        auto root = builder.initRoot<curious::message::YoutubeResourceSnapshotResponse>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_resource_snapshot_response>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_resource_snapshot_response");
-        }
-        break;
-      }
-      case message_type::youtubeResourceUpdates: {
-        auto root = builder.initRoot<curious::message::YoutubeResourceUpdates>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_resource_updates>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_resource_updates");
-        }
-        break;
-      }
-      case message_type::youtubeVideo: {
-        auto root = builder.initRoot<curious::message::YoutubeVideo>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_video>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_video");
-        }
-        break;
-      }
-      case message_type::youtubeVideoHeartbeat: {
-        auto root = builder.initRoot<curious::message::YoutubeVideoHeartbeat>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_video_heartbeat>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_video_heartbeat");
-        }
-        break;
-      }
-      case message_type::youtubeVideoSnapshotRequest: {
-        auto root = builder.initRoot<curious::message::YoutubeVideoSnapshotRequest>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_video_snapshot_request>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_video_snapshot_request");
-        }
-        break;
-      }
-      case message_type::youtubeVideoSnapshotResponse: {
-        auto root = builder.initRoot<curious::message::YoutubeVideoSnapshotResponse>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_video_snapshot_response>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_video_snapshot_response");
-        }
-        break;
-      }
-      case message_type::youtubeVideoUpdates: {
-        auto root = builder.initRoot<curious::message::YoutubeVideoUpdates>();
-        auto typedMsg = std::dynamic_pointer_cast<youtube_video_updates>(msg);
-        if (typedMsg) {
-          typedMsg->toCapnp(root);
-        } else {
-          throw std::runtime_error("Failed to cast message to type youtube_video_updates");
-        }
-        break;
-      }
-      default: throw std::runtime_error("Unknown message type");
+  static void toCapnp(capnp::MessageBuilder& builder, const network_message& msg) {
+    msg.toCapnp(builder);
+  }
+
+  static void toCapnp(capnp::MessageBuilder& builder, const std::shared_ptr<network_message>& msg) {
+    if (!msg) {
+      throw std::runtime_error("Cannot serialize null message");
     }
+    msg->toCapnp(builder);
   }
 
   static std::string serialize(const std::shared_ptr<network_message>& msg) {
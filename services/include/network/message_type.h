@@ -183,4 +183,28 @@ inline message_type fromCapnpType(curious::message::MessageType type) {
   }
 }
 
+inline bool isRequestType(message_type type) {
+  switch (type) {
+    case message_type::request:
+    case message_type::testRequest:
+    case message_type::youtubeBlogSnapshotRequest:
+    case message_type::youtubeResourceSnapshotRequest:
+    case message_type::youtubeVideoSnapshotRequest:
+      return true;
+    default: return false;
+  }
+}
+
+inline bool isReplyType(message_type type) {
+  switch (type) {
+    case message_type::reply:
+    case message_type::testReply:
+    case message_type::youtubeBlogSnapshotResponse:
+    case message_type::youtubeResourceSnapshotResponse:
+    case message_type::youtubeVideoSnapshotResponse:
+      return true;
+    default: return false;
+  }
+}
+
 }  // namespace curious::net
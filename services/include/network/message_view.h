@@ -0,0 +1,36 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <memory>
+#include <string_view>
+#include <network/message_type.h>
+#include <network/network_message.h>
+
+namespace curious::net {
+
+inline std::string_view toStringView(kj::StringPtr text) {
+  return std::string_view(text.cStr(), text.size());
+}
+
+// Read-only access to a received message without copying it out of the
+// buffer it arrived in. Every view, including views of nested fields,
+// shares ownership of that buffer, so they stay valid while any is alive.
+class message_view {
+protected:
+  std::shared_ptr<capnp::MessageReader> _message;
+  message_type _msgType;
+  kj::StringPtr _topic;
+public:
+  message_view(std::shared_ptr<capnp::MessageReader> message, message_type msgType, kj::StringPtr topic)
+    : _message(std::move(message)), _msgType(msgType), _topic(topic) {}
+  virtual ~message_view() = default;
+
+  message_type getMsgType() const { return _msgType; }
+  std::string_view getTopic() const { return toStringView(_topic); }
+  const std::shared_ptr<capnp::MessageReader>& getMessage() const { return _message; }
+
+  // Copies every field into the owning message class
+  virtual std::shared_ptr<network_message> materialize() const = 0;
+};
+
+}  // namespace curious::net
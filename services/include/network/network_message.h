@@ -31,6 +31,7 @@ public:
   void setTopic(std::string value) { _topic = value; }
 
   void toCapnp(curious::message::NetworkMessage::Builder& builder) const;
+  virtual void toCapnp(capnp::MessageBuilder& message) const;
   static network_message fromCapnp(const curious::message::NetworkMessage::Reader& reader);
   std::string serialize() const;
   static network_message deserialize(const std::string& data);
@@ -39,14 +40,32 @@ public:
 public: 
   virtual ~network_message() = default;
 
+  // Cover every type derived from request/reply, so a true result makes a
+  // static cast to request/reply safe
   bool is_request() const {
-    return _msgType == message_type::request || _msgType == message_type::testRequest;
+    return isRequestType(_msgType);
   }
 
   bool is_response() const {
-    return _msgType == message_type::reply || _msgType == message_type::testReply;
+    return isReplyType(_msgType);
   }
 
+  // Position in the sender's stream for this topic, 0 to let the server
+  // number it. Not part of the schema: the server carries it in a frame of
+  // its own next to the payload, so every message type can have one.
+  uint64_t getSequence() const { return _sequence; }
+  void setSequence(uint64_t value) { _sequence = value; }
+
+  // The sequence a received message arrived with. Kept apart from the one
+  // above so relaying a message does not resend the upstream's number; a
+  // relay that wants to keep it copies it over explicitly.
+  uint64_t getReceivedSequence() const { return _receivedSequence; }
+  void setReceivedSequence(uint64_t value) { _receivedSequence = value; }
+
+protected:
+  uint64_t _sequence = 0;
+  uint64_t _receivedSequence = 0;
+
 //#editable_class_end_dont_remove_this_line_only_write_below
 };
 }  // namespace curious::net
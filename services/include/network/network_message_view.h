@@ -0,0 +1,30 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/network_message.h>
+
+namespace curious::net {
+
+class network_message_view : public message_view {
+protected:
+  curious::message::NetworkMessage::Reader _reader;
+public:
+  explicit network_message_view(std::shared_ptr<capnp::MessageReader> message)
+    : network_message_view(message, message->getRoot<curious::message::NetworkMessage>()) {}
+
+  network_message_view(std::shared_ptr<capnp::MessageReader> message, curious::message::NetworkMessage::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  curious::message::NetworkMessage::Reader getReader() const { return _reader; }
+  network_message toOwned() const { return network_message::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<network_message>(toOwned());
+  }
+};
+}  // namespace curious::net
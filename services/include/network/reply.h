@@ -33,6 +33,7 @@ public:
   void setRequest(request value) { _request = value; }
 
   void toCapnp(curious::message::Reply::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static reply fromCapnp(const curious::message::Reply::Reader& reader);
   std::string serialize() const;
   static reply deserialize(const std::string& data);
@@ -0,0 +1,35 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/reply.h>
+#include <network/request_view.h>
+
+namespace curious::net {
+
+class reply_view : public message_view {
+protected:
+  curious::message::Reply::Reader _reader;
+public:
+  explicit reply_view(std::shared_ptr<capnp::MessageReader> message)
+    : reply_view(message, message->getRoot<curious::message::Reply>()) {}
+
+  reply_view(std::shared_ptr<capnp::MessageReader> message, curious::message::Reply::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  auto getId() const { return _reader.getId(); }
+
+  request_view getRequest() const { return request_view(_message, _reader.getRequest()); }
+
+  curious::message::Reply::Reader getReader() const { return _reader; }
+  reply toOwned() const { return reply::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<reply>(toOwned());
+  }
+};
+}  // namespace curious::net
@@ -39,11 +39,28 @@ public:
   void setReqGeneratedPort(std::string value) { _reqGeneratedPort = value; }
 
   void toCapnp(curious::message::Request::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static request fromCapnp(const curious::message::Request::Reader& reader);
   std::string serialize() const;
   static request deserialize(const std::string& data);
 //#editable_class_start_dont_remove_this_line_only_write_above
 
+public:
+  // Process-local handle the server stamps on a received request so reply()
+  // can find the peer it came from. Never serialized.
+  uint64_t getReplyToken() const { return _replyToken; }
+  void setReplyToken(uint64_t value) { _replyToken = value; }
+
+  // Whether the requester takes its answer in chunks (server::request_stream
+  // sets it; the replier checks it before calling reply_chunk). Travels in
+  // the transport's metadata frame, not the message.
+  bool getStreamReply() const { return _streamReply; }
+  void setStreamReply(bool value) { _streamReply = value; }
+
+private:
+  uint64_t _replyToken = 0;
+  bool _streamReply = false;
+
 //#editable_class_end_dont_remove_this_line_only_write_below
 };
 }  // namespace curious::net
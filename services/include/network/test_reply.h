@@ -35,6 +35,7 @@ public:
   void setResponseTest(int value) { _responseTest = value; }
 
   void toCapnp(curious::message::TestReply::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static test_reply fromCapnp(const curious::message::TestReply::Reader& reader);
   std::string serialize() const;
   static test_reply deserialize(const std::string& data);
@@ -0,0 +1,39 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/test_reply.h>
+#include <network/request_view.h>
+
+namespace curious::net {
+
+class test_reply_view : public message_view {
+protected:
+  curious::message::TestReply::Reader _reader;
+public:
+  explicit test_reply_view(std::shared_ptr<capnp::MessageReader> message)
+    : test_reply_view(message, message->getRoot<curious::message::TestReply>()) {}
+
+  test_reply_view(std::shared_ptr<capnp::MessageReader> message, curious::message::TestReply::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  auto getId() const { return _reader.getId(); }
+
+  request_view getRequest() const { return request_view(_message, _reader.getRequest()); }
+
+  std::string_view getResponse() const { return toStringView(_reader.getResponse()); }
+
+  auto getResponseTest() const { return _reader.getResponseTest(); }
+
+  curious::message::TestReply::Reader getReader() const { return _reader; }
+  test_reply toOwned() const { return test_reply::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<test_reply>(toOwned());
+  }
+};
+}  // namespace curious::net
@@ -42,6 +42,7 @@ public:
   void setAge(int value) { _age = value; }
 
   void toCapnp(curious::message::TestRequest::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static test_request fromCapnp(const curious::message::TestRequest::Reader& reader);
   std::string serialize() const;
   static test_request deserialize(const std::string& data);
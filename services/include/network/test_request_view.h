@@ -0,0 +1,42 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/test_request.h>
+
+namespace curious::net {
+
+class test_request_view : public message_view {
+protected:
+  curious::message::TestRequest::Reader _reader;
+public:
+  explicit test_request_view(std::shared_ptr<capnp::MessageReader> message)
+    : test_request_view(message, message->getRoot<curious::message::TestRequest>()) {}
+
+  test_request_view(std::shared_ptr<capnp::MessageReader> message, curious::message::TestRequest::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  auto getId() const { return _reader.getId(); }
+
+  std::string_view getReqGeneratedIp() const { return toStringView(_reader.getReqGeneratedIp()); }
+
+  std::string_view getReqGeneratedPort() const { return toStringView(_reader.getReqGeneratedPort()); }
+
+  std::string_view getMessage() const { return toStringView(_reader.getMessage()); }
+
+  std::string_view getUser() const { return toStringView(_reader.getUser()); }
+
+  auto getAge() const { return _reader.getAge(); }
+
+  curious::message::TestRequest::Reader getReader() const { return _reader; }
+  test_request toOwned() const { return test_request::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<test_request>(toOwned());
+  }
+};
+}  // namespace curious::net
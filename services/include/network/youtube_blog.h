@@ -53,6 +53,7 @@ public:
   void setContentHtml(std::string value) { _contentHtml = value; }
 
   void toCapnp(curious::message::YoutubeBlog::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_blog fromCapnp(const curious::message::YoutubeBlog::Reader& reader);
   std::string serialize() const;
   static youtube_blog deserialize(const std::string& data);
@@ -28,6 +28,7 @@ public:
   void setResourcesCount(int value) { _resourcesCount = value; }
 
   void toCapnp(curious::message::YoutubeBlogHeartbeat::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_blog_heartbeat fromCapnp(const curious::message::YoutubeBlogHeartbeat::Reader& reader);
   std::string serialize() const;
   static youtube_blog_heartbeat deserialize(const std::string& data);
@@ -0,0 +1,32 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/youtube_blog_heartbeat.h>
+
+namespace curious::net {
+
+class youtube_blog_heartbeat_view : public message_view {
+protected:
+  curious::message::YoutubeBlogHeartbeat::Reader _reader;
+public:
+  explicit youtube_blog_heartbeat_view(std::shared_ptr<capnp::MessageReader> message)
+    : youtube_blog_heartbeat_view(message, message->getRoot<curious::message::YoutubeBlogHeartbeat>()) {}
+
+  youtube_blog_heartbeat_view(std::shared_ptr<capnp::MessageReader> message, curious::message::YoutubeBlogHeartbeat::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  auto getResourcesCount() const { return _reader.getResourcesCount(); }
+
+  curious::message::YoutubeBlogHeartbeat::Reader getReader() const { return _reader; }
+  youtube_blog_heartbeat toOwned() const { return youtube_blog_heartbeat::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<youtube_blog_heartbeat>(toOwned());
+  }
+};
+}  // namespace curious::net
@@ -25,6 +25,7 @@ public:
   }
 
   void toCapnp(curious::message::YoutubeBlogSnapshotRequest::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_blog_snapshot_request fromCapnp(const curious::message::YoutubeBlogSnapshotRequest::Reader& reader);
   std::string serialize() const;
   static youtube_blog_snapshot_request deserialize(const std::string& data);
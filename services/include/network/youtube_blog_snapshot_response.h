@@ -30,6 +30,7 @@ public:
   void setBlogs(std::vector<youtube_blog> value) { _blogs = value; }
 
   void toCapnp(curious::message::YoutubeBlogSnapshotResponse::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_blog_snapshot_response fromCapnp(const curious::message::YoutubeBlogSnapshotResponse::Reader& reader);
   std::string serialize() const;
   static youtube_blog_snapshot_response deserialize(const std::string& data);
@@ -29,6 +29,7 @@ public:
   void setUpdates(std::vector<youtube_blog> value) { _updates = value; }
 
   void toCapnp(curious::message::YoutubeBlogUpdates::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_blog_updates fromCapnp(const curious::message::YoutubeBlogUpdates::Reader& reader);
   std::string serialize() const;
   static youtube_blog_updates deserialize(const std::string& data);
@@ -0,0 +1,36 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/youtube_blog_updates.h>
+#include <network/youtube_blog_view.h>
+
+namespace curious::net {
+
+class youtube_blog_updates_view : public message_view {
+protected:
+  curious::message::YoutubeBlogUpdates::Reader _reader;
+public:
+  explicit youtube_blog_updates_view(std::shared_ptr<capnp::MessageReader> message)
+    : youtube_blog_updates_view(message, message->getRoot<curious::message::YoutubeBlogUpdates>()) {}
+
+  youtube_blog_updates_view(std::shared_ptr<capnp::MessageReader> message, curious::message::YoutubeBlogUpdates::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  size_t getUpdatesCount() const { return _reader.getUpdates().size(); }
+  youtube_blog_view getUpdatesAt(size_t index) const {
+    return youtube_blog_view(_message, _reader.getUpdates()[index]);
+  }
+
+  curious::message::YoutubeBlogUpdates::Reader getReader() const { return _reader; }
+  youtube_blog_updates toOwned() const { return youtube_blog_updates::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<youtube_blog_updates>(toOwned());
+  }
+};
+}  // namespace curious::net
@@ -0,0 +1,42 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/youtube_blog.h>
+
+namespace curious::net {
+
+class youtube_blog_view : public message_view {
+protected:
+  curious::message::YoutubeBlog::Reader _reader;
+public:
+  explicit youtube_blog_view(std::shared_ptr<capnp::MessageReader> message)
+    : youtube_blog_view(message, message->getRoot<curious::message::YoutubeBlog>()) {}
+
+  youtube_blog_view(std::shared_ptr<capnp::MessageReader> message, curious::message::YoutubeBlog::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  std::string_view getBlogId() const { return toStringView(_reader.getBlogId()); }
+
+  std::string_view getTitle() const { return toStringView(_reader.getTitle()); }
+
+  std::string_view getSlug() const { return toStringView(_reader.getSlug()); }
+
+  std::string_view getCoverImageUrl() const { return toStringView(_reader.getCoverImageUrl()); }
+
+  std::string_view getPublishedDate() const { return toStringView(_reader.getPublishedDate()); }
+
+  std::string_view getContentHtml() const { return toStringView(_reader.getContentHtml()); }
+
+  curious::message::YoutubeBlog::Reader getReader() const { return _reader; }
+  youtube_blog toOwned() const { return youtube_blog::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<youtube_blog>(toOwned());
+  }
+};
+}  // namespace curious::net
@@ -43,6 +43,7 @@ public:
   void setDescription(std::string value) { _description = value; }
 
   void toCapnp(curious::message::YoutubeResource::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_resource fromCapnp(const curious::message::YoutubeResource::Reader& reader);
   std::string serialize() const;
   static youtube_resource deserialize(const std::string& data);
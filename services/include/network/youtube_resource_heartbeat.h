@@ -28,6 +28,7 @@ public:
   void setResourcesCount(int value) { _resourcesCount = value; }
 
   void toCapnp(curious::message::YoutubeResourceHeartbeat::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_resource_heartbeat fromCapnp(const curious::message::YoutubeResourceHeartbeat::Reader& reader);
   std::string serialize() const;
   static youtube_resource_heartbeat deserialize(const std::string& data);
@@ -0,0 +1,32 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/youtube_resource_heartbeat.h>
+
+namespace curious::net {
+
+class youtube_resource_heartbeat_view : public message_view {
+protected:
+  curious::message::YoutubeResourceHeartbeat::Reader _reader;
+public:
+  explicit youtube_resource_heartbeat_view(std::shared_ptr<capnp::MessageReader> message)
+    : youtube_resource_heartbeat_view(message, message->getRoot<curious::message::YoutubeResourceHeartbeat>()) {}
+
+  youtube_resource_heartbeat_view(std::shared_ptr<capnp::MessageReader> message, curious::message::YoutubeResourceHeartbeat::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  auto getResourcesCount() const { return _reader.getResourcesCount(); }
+
+  curious::message::YoutubeResourceHeartbeat::Reader getReader() const { return _reader; }
+  youtube_resource_heartbeat toOwned() const { return youtube_resource_heartbeat::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<youtube_resource_heartbeat>(toOwned());
+  }
+};
+}  // namespace curious::net
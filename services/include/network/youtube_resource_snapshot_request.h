@@ -25,6 +25,7 @@ public:
   }
 
   void toCapnp(curious::message::YoutubeResourceSnapshotRequest::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_resource_snapshot_request fromCapnp(const curious::message::YoutubeResourceSnapshotRequest::Reader& reader);
   std::string serialize() const;
   static youtube_resource_snapshot_request deserialize(const std::string& data);
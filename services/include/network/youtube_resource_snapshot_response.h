@@ -30,6 +30,7 @@ public:
   void setResources(std::vector<youtube_resource> value) { _resources = value; }
 
   void toCapnp(curious::message::YoutubeResourceSnapshotResponse::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_resource_snapshot_response fromCapnp(const curious::message::YoutubeResourceSnapshotResponse::Reader& reader);
   std::string serialize() const;
   static youtube_resource_snapshot_response deserialize(const std::string& data);
@@ -0,0 +1,41 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/youtube_resource_snapshot_response.h>
+#include <network/request_view.h>
+#include <network/youtube_resource_view.h>
+
+namespace curious::net {
+
+class youtube_resource_snapshot_response_view : public message_view {
+protected:
+  curious::message::YoutubeResourceSnapshotResponse::Reader _reader;
+public:
+  explicit youtube_resource_snapshot_response_view(std::shared_ptr<capnp::MessageReader> message)
+    : youtube_resource_snapshot_response_view(message, message->getRoot<curious::message::YoutubeResourceSnapshotResponse>()) {}
+
+  youtube_resource_snapshot_response_view(std::shared_ptr<capnp::MessageReader> message, curious::message::YoutubeResourceSnapshotResponse::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  auto getId() const { return _reader.getId(); }
+
+  request_view getRequest() const { return request_view(_message, _reader.getRequest()); }
+
+  size_t getResourcesCount() const { return _reader.getResources().size(); }
+  youtube_resource_view getResourcesAt(size_t index) const {
+    return youtube_resource_view(_message, _reader.getResources()[index]);
+  }
+
+  curious::message::YoutubeResourceSnapshotResponse::Reader getReader() const { return _reader; }
+  youtube_resource_snapshot_response toOwned() const { return youtube_resource_snapshot_response::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<youtube_resource_snapshot_response>(toOwned());
+  }
+};
+}  // namespace curious::net
@@ -29,6 +29,7 @@ public:
   void setUpdates(std::vector<youtube_resource> value) { _updates = value; }
 
   void toCapnp(curious::message::YoutubeResourceUpdates::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_resource_updates fromCapnp(const curious::message::YoutubeResourceUpdates::Reader& reader);
   std::string serialize() const;
   static youtube_resource_updates deserialize(const std::string& data);
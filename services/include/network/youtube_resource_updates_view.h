@@ -0,0 +1,36 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/youtube_resource_updates.h>
+#include <network/youtube_resource_view.h>
+
+namespace curious::net {
+
+class youtube_resource_updates_view : public message_view {
+protected:
+  curious::message::YoutubeResourceUpdates::Reader _reader;
+public:
+  explicit youtube_resource_updates_view(std::shared_ptr<capnp::MessageReader> message)
+    : youtube_resource_updates_view(message, message->getRoot<curious::message::YoutubeResourceUpdates>()) {}
+
+  youtube_resource_updates_view(std::shared_ptr<capnp::MessageReader> message, curious::message::YoutubeResourceUpdates::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  size_t getUpdatesCount() const { return _reader.getUpdates().size(); }
+  youtube_resource_view getUpdatesAt(size_t index) const {
+    return youtube_resource_view(_message, _reader.getUpdates()[index]);
+  }
+
+  curious::message::YoutubeResourceUpdates::Reader getReader() const { return _reader; }
+  youtube_resource_updates toOwned() const { return youtube_resource_updates::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<youtube_resource_updates>(toOwned());
+  }
+};
+}  // namespace curious::net
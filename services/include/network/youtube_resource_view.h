@@ -0,0 +1,38 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/youtube_resource.h>
+
+namespace curious::net {
+
+class youtube_resource_view : public message_view {
+protected:
+  curious::message::YoutubeResource::Reader _reader;
+public:
+  explicit youtube_resource_view(std::shared_ptr<capnp::MessageReader> message)
+    : youtube_resource_view(message, message->getRoot<curious::message::YoutubeResource>()) {}
+
+  youtube_resource_view(std::shared_ptr<capnp::MessageReader> message, curious::message::YoutubeResource::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  std::string_view getResourceId() const { return toStringView(_reader.getResourceId()); }
+
+  std::string_view getTitle() const { return toStringView(_reader.getTitle()); }
+
+  std::string_view getData() const { return toStringView(_reader.getData()); }
+
+  std::string_view getDescription() const { return toStringView(_reader.getDescription()); }
+
+  curious::message::YoutubeResource::Reader getReader() const { return _reader; }
+  youtube_resource toOwned() const { return youtube_resource::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<youtube_resource>(toOwned());
+  }
+};
+}  // namespace curious::net
@@ -58,6 +58,7 @@ public:
   void setThumbnailMaxres(std::string value) { _thumbnailMaxres = value; }
 
   void toCapnp(curious::message::YoutubeVideo::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_video fromCapnp(const curious::message::YoutubeVideo::Reader& reader);
   std::string serialize() const;
   static youtube_video deserialize(const std::string& data);
@@ -28,6 +28,7 @@ public:
   void setVideosCount(int value) { _videosCount = value; }
 
   void toCapnp(curious::message::YoutubeVideoHeartbeat::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_video_heartbeat fromCapnp(const curious::message::YoutubeVideoHeartbeat::Reader& reader);
   std::string serialize() const;
   static youtube_video_heartbeat deserialize(const std::string& data);
@@ -0,0 +1,32 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/youtube_video_heartbeat.h>
+
+namespace curious::net {
+
+class youtube_video_heartbeat_view : public message_view {
+protected:
+  curious::message::YoutubeVideoHeartbeat::Reader _reader;
+public:
+  explicit youtube_video_heartbeat_view(std::shared_ptr<capnp::MessageReader> message)
+    : youtube_video_heartbeat_view(message, message->getRoot<curious::message::YoutubeVideoHeartbeat>()) {}
+
+  youtube_video_heartbeat_view(std::shared_ptr<capnp::MessageReader> message, curious::message::YoutubeVideoHeartbeat::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  auto getVideosCount() const { return _reader.getVideosCount(); }
+
+  curious::message::YoutubeVideoHeartbeat::Reader getReader() const { return _reader; }
+  youtube_video_heartbeat toOwned() const { return youtube_video_heartbeat::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<youtube_video_heartbeat>(toOwned());
+  }
+};
+}  // namespace curious::net
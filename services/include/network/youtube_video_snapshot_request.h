@@ -25,6 +25,7 @@ public:
   }
 
   void toCapnp(curious::message::YoutubeVideoSnapshotRequest::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_video_snapshot_request fromCapnp(const curious::message::YoutubeVideoSnapshotRequest::Reader& reader);
   std::string serialize() const;
   static youtube_video_snapshot_request deserialize(const std::string& data);
@@ -0,0 +1,36 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/youtube_video_snapshot_request.h>
+
+namespace curious::net {
+
+class youtube_video_snapshot_request_view : public message_view {
+protected:
+  curious::message::YoutubeVideoSnapshotRequest::Reader _reader;
+public:
+  explicit youtube_video_snapshot_request_view(std::shared_ptr<capnp::MessageReader> message)
+    : youtube_video_snapshot_request_view(message, message->getRoot<curious::message::YoutubeVideoSnapshotRequest>()) {}
+
+  youtube_video_snapshot_request_view(std::shared_ptr<capnp::MessageReader> message, curious::message::YoutubeVideoSnapshotRequest::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  auto getId() const { return _reader.getId(); }
+
+  std::string_view getReqGeneratedIp() const { return toStringView(_reader.getReqGeneratedIp()); }
+
+  std::string_view getReqGeneratedPort() const { return toStringView(_reader.getReqGeneratedPort()); }
+
+  curious::message::YoutubeVideoSnapshotRequest::Reader getReader() const { return _reader; }
+  youtube_video_snapshot_request toOwned() const { return youtube_video_snapshot_request::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<youtube_video_snapshot_request>(toOwned());
+  }
+};
+}  // namespace curious::net
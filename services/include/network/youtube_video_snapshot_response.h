@@ -30,6 +30,7 @@ public:
   void setVideos(std::vector<youtube_video> value) { _videos = value; }
 
   void toCapnp(curious::message::YoutubeVideoSnapshotResponse::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_video_snapshot_response fromCapnp(const curious::message::YoutubeVideoSnapshotResponse::Reader& reader);
   std::string serialize() const;
   static youtube_video_snapshot_response deserialize(const std::string& data);
@@ -29,6 +29,7 @@ public:
   void setVideos(std::vector<youtube_video> value) { _videos = value; }
 
   void toCapnp(curious::message::YoutubeVideoUpdates::Builder& builder) const;
+  void toCapnp(capnp::MessageBuilder& message) const override;
   static youtube_video_updates fromCapnp(const curious::message::YoutubeVideoUpdates::Reader& reader);
   std::string serialize() const;
   static youtube_video_updates deserialize(const std::string& data);
@@ -0,0 +1,36 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/youtube_video_updates.h>
+#include <network/youtube_video_view.h>
+
+namespace curious::net {
+
+class youtube_video_updates_view : public message_view {
+protected:
+  curious::message::YoutubeVideoUpdates::Reader _reader;
+public:
+  explicit youtube_video_updates_view(std::shared_ptr<capnp::MessageReader> message)
+    : youtube_video_updates_view(message, message->getRoot<curious::message::YoutubeVideoUpdates>()) {}
+
+  youtube_video_updates_view(std::shared_ptr<capnp::MessageReader> message, curious::message::YoutubeVideoUpdates::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  size_t getVideosCount() const { return _reader.getVideos().size(); }
+  youtube_video_view getVideosAt(size_t index) const {
+    return youtube_video_view(_message, _reader.getVideos()[index]);
+  }
+
+  curious::message::YoutubeVideoUpdates::Reader getReader() const { return _reader; }
+  youtube_video_updates toOwned() const { return youtube_video_updates::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<youtube_video_updates>(toOwned());
+  }
+};
+}  // namespace curious::net
@@ -0,0 +1,44 @@
+#pragma once
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <network/message_view.h>
+#include <network/youtube_video.h>
+
+namespace curious::net {
+
+class youtube_video_view : public message_view {
+protected:
+  curious::message::YoutubeVideo::Reader _reader;
+public:
+  explicit youtube_video_view(std::shared_ptr<capnp::MessageReader> message)
+    : youtube_video_view(message, message->getRoot<curious::message::YoutubeVideo>()) {}
+
+  youtube_video_view(std::shared_ptr<capnp::MessageReader> message, curious::message::YoutubeVideo::Reader reader)
+    : message_view(std::move(message), fromCapnpType(reader.getMsgType()), reader.getTopic()),
+      _reader(reader) {}
+
+  std::string_view getVideoId() const { return toStringView(_reader.getVideoId()); }
+
+  std::string_view getTitle() const { return toStringView(_reader.getTitle()); }
+
+  std::string_view getThumbnail() const { return toStringView(_reader.getThumbnail()); }
+
+  std::string_view getThumbnailMedium() const { return toStringView(_reader.getThumbnailMedium()); }
+
+  std::string_view getThumbnailHigh() const { return toStringView(_reader.getThumbnailHigh()); }
+
+  std::string_view getThumbnailStandard() const { return toStringView(_reader.getThumbnailStandard()); }
+
+  std::string_view getThumbnailMaxres() const { return toStringView(_reader.getThumbnailMaxres()); }
+
+  curious::message::YoutubeVideo::Reader getReader() const { return _reader; }
+  youtube_video toOwned() const { return youtube_video::fromCapnp(_reader); }
+  std::shared_ptr<network_message> materialize() const override {
+    return std::make_shared<youtube_video>(toOwned());
+  }
+};
+}  // namespace curious::net
@@ -113,10 +113,34 @@ public:
         file << "  }\n";
         file << "}\n\n";
         
+        // isRequestType / isReplyType: true for the base type and everything extending it
+        for (const auto& [base, fn] : {std::pair<std::string, std::string>{"Request", "isRequestType"},
+                                       std::pair<std::string, std::string>{"Reply", "isReplyType"}}) {
+            file << "inline bool " << fn << "(message_type type) {\n";
+            file << "  switch (type) {\n";
+            for (const auto& [name, msg] : messages) {
+                if (!extends(msg, base)) continue;
+                std::string enumName = toCamelCase(name);
+                enumName[0] = std::tolower(enumName[0]);
+                file << "    case message_type::" << enumName << ":\n";
+            }
+            file << "      return true;\n";
+            file << "    default: return false;\n";
+            file << "  }\n";
+            file << "}\n\n";
+        }
+        
         file << "}  // namespace curious::net\n";
         file.close();
     }
 
+    // True if msg is ancestor itself or derives from it
+    bool extends(const Message& msg, const std::string& ancestor) const {
+        if (msg.name == ancestor) return true;
+        auto parentIt = messages.find(msg.parent);
+        return parentIt != messages.end() && extends(parentIt->second, ancestor);
+    }
+
     // Generate factory builder header
     void generateFactoryBuilder(const std::string& outputDir) const {
         std::filesystem::create_directories(outputDir + "/include/network");
@@ -133,6 +157,9 @@ public:
         for (const auto& [name, msg] : messages) {
             file << "#include <network/" << toLowerSnakeCase(name) << ".h>\n";
         }
+        for (const auto& [name, msg] : messages) {
+            file << "#include <network/" << toLowerSnakeCase(name) << "_view.h>\n";
+        }
 
         file << "\nnamespace curious::net {\n\n";
 
@@ -180,28 +207,28 @@ public:
         file << "    }\n";
         file << "  }\n\n";
 
-        // toCapnp function - calls child's toCapnp function given type and a shared_ptr<network_message>
-        file << "  static void toCapnp(capnp::MallocMessageBuilder& builder, const std::shared_ptr<network_message>& msg) {\n";
-        file << "    if (!msg) {\n";
-        file << "      throw std::runtime_error(\"Cannot serialize null message\");\n";
-        file << "    }\n\n";
-        file << "    switch (msg->getMsgType()) {\n";
+        // createView function - wraps a reader in the matching read-only view, copying nothing
+        file << "  static std::shared_ptr<message_view> createView(std::shared_ptr<capnp::MessageReader> reader) {\n";
+        file << "    auto msgType = curious::net::fromCapnp(reader->getRoot<curious::message::NetworkMessage>());\n";
+        file << "    switch (msgType) {\n";
         for (const auto& [name, msg] : messages) {
             std::string enumName = toCamelCase(name);
             enumName[0] = std::tolower(enumName[0]);
-            file << "      case message_type::" << enumName << ": {\n";
-            file << "        auto root = builder.initRoot<curious::message::" << msg.name << ">();\n";
-            file << "        auto typedMsg = std::dynamic_pointer_cast<" << toLowerSnakeCase(name) << ">(msg);\n";
-            file << "        if (typedMsg) {\n";
-            file << "          typedMsg->toCapnp(root);\n";
-            file << "        } else {\n";
-            file << "          throw std::runtime_error(\"Failed to cast message to type " << toLowerSnakeCase(name) << "\");\n";
-            file << "        }\n";
-            file << "        break;\n";
-            file << "      }\n";
+            file << "      case message_type::" << enumName << ": return std::make_shared<" << toLowerSnakeCase(name) << "_view>(std::move(reader));\n";
         }
-        file << "      default: throw std::runtime_error(\"Unknown message type\");\n";
+        file << "      default: return nullptr; // Unknown message type\n";
+        file << "    }\n";
+        file << "  }\n\n";
+
+        // toCapnp function - the message's virtual toCapnp picks the root type, so no casts are needed
+        file << "  static void toCapnp(capnp::MessageBuilder& builder, const network_message& msg) {\n";
+        file << "    msg.toCapnp(builder);\n";
+        file << "  }\n\n";
+        file << "  static void toCapnp(capnp::MessageBuilder& builder, const std::shared_ptr<network_message>& msg) {\n";
+        file << "    if (!msg) {\n";
+        file << "      throw std::runtime_error(\"Cannot serialize null message\");\n";
         file << "    }\n";
+        file << "    msg->toCapnp(builder);\n";
         file << "  }\n\n";
 
         // Serialize function - convenience method that combines toCapnp with serialization
@@ -30,6 +30,7 @@ private:
     
     void generateToCapnpImpl(std::ostringstream& out, const Message& msg, 
                             const std::string& className, const std::vector<Field>& allFields) const;
+    void generateToCapnpRootImpl(std::ostringstream& out, const Message& msg, const std::string& className) const;
     void generateFromCapnpImpl(std::ostringstream& out, const Message& msg, 
                               const std::string& className, const std::vector<Field>& allFields) const;
     void generateSerializeImpl(std::ostringstream& out, const Message& msg, const std::string& className) const;
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <set>
+#include <vector>
+#include <sstream>
+#include <parsers/network/types.h>
+
+namespace parser {
+
+/**
+ * Emits read-only view classes (<name>_view.h) that wrap a Cap'n Proto
+ * reader and hand out fields lazily instead of copying them into the
+ * owning message classes.
+ */
+class CppViewGenerator {
+public:
+    explicit CppViewGenerator(const std::map<std::string, Message>& messages);
+    void generate(const std::string& outputDir);
+
+private:
+    const std::map<std::string, Message>& messages;
+
+    void collectAllFields(const Message& msg, std::vector<Field>& allFields) const;
+    bool isBuiltinType(const std::string& type) const;
+    std::string getViewName(const std::string& name) const;
+    std::string getAccessorName(const std::string& name) const;
+
+    void generateBaseView(const std::string& outputDir) const;
+    void generateIncludes(std::ostringstream& out, const Message& msg, const std::vector<Field>& allFields) const;
+    void generateClass(std::ostringstream& out, const Message& msg, const std::vector<Field>& allFields) const;
+    void generateAccessor(std::ostringstream& out, const Field& field) const;
+};
+
+}  // namespace parser
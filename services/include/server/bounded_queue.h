@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace curious::core {
+
+/**
+ * @brief Fixed-capacity lock-free ring for many producers and consumers.
+ *
+ * Every slot carries a sequence number that tells producers and consumers
+ * whose turn it is, so a push or pop is one CAS on a shared cursor plus a
+ * store to the slot; nothing is allocated after construction. Capacity is
+ * rounded up to a power of two.
+ *
+ * try_push() leaves the value untouched when the ring is full, so callers
+ * can decide what to drop. Consumers may be several threads, which is what
+ * lets a producer evict the oldest entry itself.
+ */
+template <typename T>
+class bounded_queue {
+public:
+    explicit bounded_queue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        _mask = size - 1;
+        _cells = std::make_unique<cell[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bounded_queue(const bounded_queue&) = delete;
+    bounded_queue& operator=(const bounded_queue&) = delete;
+
+    size_t capacity() const { return _mask + 1; }
+
+    /// Moves value in and returns true, or returns false (value intact) when full.
+    bool try_push(T& value) {
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        cell* slot;
+        while (true) {
+            slot = &_cells[pos & _mask];
+            const size_t seq = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value.emplace(std::move(value));
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> try_pop() {
+        size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        cell* slot;
+        while (true) {
+            slot = &_cells[pos & _mask];
+            const size_t seq = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return std::nullopt;
+            } else {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        std::optional<T> value = std::move(slot->value);
+        slot->value.reset();
+        slot->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return value;
+    }
+
+    /// Snapshot only; another thread may change the answer right away.
+    bool empty() const {
+        const size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        return _cells[pos & _mask].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+private:
+    struct cell {
+        std::atomic<size_t> sequence{0};
+        std::optional<T> value;
+    };
+
+    std::unique_ptr<cell[]> _cells;
+    size_t _mask = 0;
+    alignas(64) std::atomic<size_t> _enqueuePos{0};
+    alignas(64) std::atomic<size_t> _dequeuePos{0};
+};
+
+}  // namespace curious::core
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace curious::core {
+
+/**
+ * @brief Runs user callbacks on a fixed set of worker threads.
+ *
+ * Work is queued per topic. Tasks of one topic run one after another in
+ * submission order, while different topics run in parallel. Each topic's
+ * queue is bounded; submit() refuses work once a topic is at its limit so
+ * a slow handler cannot make the I/O thread buffer without end. Tasks that
+ * must not be lost (completions someone is waiting on) may skip the limit;
+ * they are few and still queue in order with the rest.
+ */
+class dispatch_pool {
+public:
+    dispatch_pool(size_t threadCount, size_t defaultMaxQueueDepth);
+    ~dispatch_pool();
+
+    dispatch_pool(const dispatch_pool&) = delete;
+    dispatch_pool& operator=(const dispatch_pool&) = delete;
+
+    /// Overrides the queue-depth limit for one topic.
+    void set_max_queue_depth(const std::string& topic, size_t depth);
+
+    /// Queues a task behind earlier tasks of the same topic.
+    /// Returns false if the topic's queue is full (only checked when
+    /// bounded) or the pool is stopping.
+    bool submit(const std::string& topic, std::function<void()> task, bool bounded = true);
+
+    /// Stops the workers. Bounded tasks that have not started yet are
+    /// discarded; unbounded ones are handed back, in submission order per
+    /// topic, for the caller to run.
+    std::vector<std::function<void()>> stop();
+
+private:
+    struct queued_task {
+        std::function<void()> run;
+        bool bounded = true;
+    };
+
+    struct topic_queue {
+        std::deque<queued_task> tasks;
+        size_t maxDepth = 0;
+        bool scheduled = false;  // queued in _ready or currently running
+    };
+
+    void _worker_loop();
+
+    std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::unordered_map<std::string, topic_queue> _queues;
+    std::deque<topic_queue*> _ready;
+    std::vector<std::thread> _workers;
+    size_t _defaultMaxQueueDepth;
+    bool _stopping = false;
+};
+
+}  // namespace curious::core
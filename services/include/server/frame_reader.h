@@ -0,0 +1,43 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <capnp/message.h>
+#include <capnp/serialize.h>
+#include <kj/array.h>
+#include <kj/io.h>
+#include <memory>
+
+namespace curious::core {
+
+/**
+ * @brief A Cap'n Proto reader over a received ZeroMQ frame.
+ *
+ * Owns the frame so the reader can point straight into it. When the frame
+ * is word-aligned (the usual case for large messages, which libzmq keeps
+ * in their own heap block) nothing is copied. Frames that land unaligned,
+ * e.g. small messages stored inside zmq_msg_t or ones sliced out of a
+ * shared TCP receive buffer, are copied once into an aligned array first.
+ * Packed frames (see server_config's per-topic "compression") are always
+ * unpacked into memory of the reader's own.
+ */
+class frame_reader {
+public:
+    explicit frame_reader(zmq::message_t&& frame, bool packed = false,
+                          capnp::ReaderOptions options = capnp::ReaderOptions());
+
+    frame_reader(const frame_reader&) = delete;
+    frame_reader& operator=(const frame_reader&) = delete;
+
+    capnp::MessageReader& reader() { return *_reader; }
+
+    /// True when the reader reads the frame in place.
+    bool zero_copy() const { return _copy.size() == 0 && !_input; }
+
+private:
+    zmq::message_t _frame;
+    kj::Array<capnp::word> _copy;  // only filled for unaligned frames
+    std::unique_ptr<kj::ArrayInputStream> _input;  // packed frames; read lazily by _reader
+    std::unique_ptr<capnp::MessageReader> _reader;
+};
+
+}  // namespace curious::core
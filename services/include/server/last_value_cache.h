@@ -0,0 +1,57 @@
+#pragma once
+
+#include <server/server.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace curious::core {
+
+/**
+ * @brief Re-publishes upstream topics and hands late joiners the latest
+ *        value of each one the moment they subscribe.
+ *
+ * Subscribes upstream to the configured cache topics, keeps the newest
+ * message per topic (or per topic and key, see set_key_extractor) and
+ * forwards everything downstream on an XPUB socket. XPUB reports every
+ * subscription, including repeats of a filter already held by another
+ * peer, so a new subscriber gets the cached values for its filter within
+ * one round trip instead of waiting for the next upstream publish.
+ *
+ * XPUB cannot address one peer, so a replay also reaches subscribers that
+ * already hold the filter. Replays therefore go out without a sequence number:
+ * an existing subscriber sees one unsequenced duplicate rather than a
+ * sequence that went backwards, and a new one takes its gap-detection
+ * baseline from the first live message. This suits topics whose messages
+ * carry full state; delta streams should resync from a snapshot instead.
+ *
+ * Configured by the "cache" section: {"endpoint": ..., "topics": [...]}.
+ * Messages are forwarded as raw frames and only decoded to find a key.
+ */
+class last_value_cache : public server {
+public:
+    // Returns the cache key of a message, e.g. a video id; messages with
+    // the same topic and key replace each other
+    using key_extractor = std::function<std::string(const curious::net::network_message&)>;
+
+    last_value_cache(const server_config& config, const std::string& serverName);
+
+    // Must be set before start()
+    void set_key_extractor(key_extractor extractor) { _keyOf = std::move(extractor); }
+
+    void run_loop() override;
+
+private:
+    void _on_upstream(std::vector<zmq::message_t>& frames, zmq::socket_t& downstream);
+    void _on_subscription(const zmq::message_t& frame, zmq::socket_t& downstream);
+    std::string _key_of(const zmq::message_t& dataFrame, bool packed) const;
+
+    key_extractor _keyOf;
+    // topic -> key -> [topic][data][metadata?]; ordered so a filter is a range scan
+    std::map<std::string, std::map<std::string, std::vector<zmq::message_t>>, std::less<>> _cache;
+    size_t _forwarded = 0;
+    size_t _replayed = 0;
+};
+
+}  // namespace curious::core
@@ -5,8 +5,8 @@
 /**
  * @brief Base interface for handling network events.
  * 
- * All methods are pure virtual. Classes inheriting from `listener`
- * must override all three methods to handle request/response/message types.
+ * The three handlers are pure virtual. Classes inheriting from `listener`
+ * must override all three to handle request/response/message types.
  */
 namespace curious::net {
     class network_message; // Forward declaration
@@ -21,6 +21,10 @@ public:
     /// Called when a response to a previous request is received.
     virtual void on_reply(std::shared_ptr<curious::net::network_message> resp) = 0;
 
+    /// Called for every chunk of a streamed reply except the last, which
+    /// arrives through on_reply. Ignored unless overridden.
+    virtual void on_reply_chunk(std::shared_ptr<curious::net::network_message> chunk) {}
+
     /// Called when a published message is received.
     virtual void on_message(std::shared_ptr<curious::net::network_message> msg) = 0;
 };
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace curious::core {
+
+/**
+ * @brief Unbounded lock-free multi-producer / single-consumer queue.
+ *
+ * Any thread may push(); only one thread may pop(). A push is one
+ * allocation and one atomic exchange, so producers never wait on each
+ * other or on the consumer. Items pushed by one thread come out in the
+ * order that thread pushed them.
+ *
+ * A push that is still linking its node can be invisible to pop() for a
+ * moment; callers that sleep when the queue looks empty must re-check
+ * after the producer signals them, which the server's wakeup does.
+ */
+template <typename T>
+class mpsc_queue {
+public:
+    mpsc_queue() : _head(new node), _tail(_head.load(std::memory_order_relaxed)) {}
+
+    ~mpsc_queue() {
+        while (pop()) {}
+        delete _tail;
+    }
+
+    mpsc_queue(const mpsc_queue&) = delete;
+    mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+    void push(T value) {
+        node* item = new node(std::move(value));
+        node* prev = _head.exchange(item, std::memory_order_acq_rel);
+        prev->next.store(item, std::memory_order_release);
+    }
+
+    /// Consumer thread only. Empty when nothing is (visibly) queued.
+    std::optional<T> pop() {
+        node* tail = _tail;
+        node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) return std::nullopt;
+
+        // next becomes the new stub; its value moves out to the caller
+        std::optional<T> value = std::move(next->value);
+        next->value.reset();
+        _tail = next;
+        delete tail;
+        return value;
+    }
+
+private:
+    struct node {
+        node() = default;
+        explicit node(T&& v) : value(std::move(v)) {}
+
+        std::atomic<node*> next{nullptr};
+        std::optional<T> value;
+    };
+
+    std::atomic<node*> _head;  // last pushed node, shared by producers
+    node* _tail;               // stub before the oldest item, consumer only
+};
+
+}  // namespace curious::core
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <network/message_type.h>
+#include <capnp/message.h>
+#include <optional>
+
+namespace curious::core {
+
+/**
+ * @brief A Cap'n Proto builder for one outbound message, backed by
+ *        thread-local memory that is reused from message to message.
+ *
+ * Each thread keeps one zeroed buffer that the builder uses as its first
+ * segment. MallocMessageBuilder zeroes whatever it used when it is
+ * destroyed, so the buffer can go straight to the next message. How big
+ * the first segment should be is learned per message_type from what
+ * earlier messages of that type needed, so once warmed up a message fits
+ * in the first segment and building it does no heap allocation.
+ *
+ * Only one outbound_builder per thread uses the shared buffer at a time;
+ * a nested one, or one for a message too large to keep around, falls back
+ * to a normal heap-backed builder sized by the learned hint.
+ */
+class outbound_builder {
+public:
+    explicit outbound_builder(curious::net::message_type type);
+    ~outbound_builder();
+
+    outbound_builder(const outbound_builder&) = delete;
+    outbound_builder& operator=(const outbound_builder&) = delete;
+
+    capnp::MallocMessageBuilder& get() { return *_builder; }
+
+private:
+    curious::net::message_type _type;
+    bool _pooled = false;
+    std::optional<capnp::MallocMessageBuilder> _builder;
+};
+
+}  // namespace curious::core
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace curious::core {
+
+/**
+ * @brief What the metadata frame after a payload frame says about it.
+ *
+ * A payload frame may be followed by one metadata frame of 18 bytes: a
+ * marker byte, a flags byte, the sender's publisher id (4 bytes), its
+ * sequence number for the payload (8 bytes) and, on stream requests, the
+ * requester's timeout in milliseconds (4 bytes), all little-endian.
+ *
+ * Requests and replies can carry several payloads in one message, so the
+ * metadata has to be told from payload by content, not by position. An
+ * unpacked Cap'n Proto message is whole words, which 18 bytes is not. A
+ * packed one starts with the tag byte of its segment table word, which has
+ * a high-nibble bit set for the nonzero size of the first segment; the
+ * marker's high nibble is zero.
+ */
+struct payload_meta {
+    static constexpr uint8_t kFlagPacked = 0x01;  // payload is in Cap'n Proto packed encoding
+    static constexpr uint8_t kFlagMore = 0x02;    // reply chunk; more chunks for the same request follow
+    static constexpr uint8_t kFlagStream = 0x04;  // request; the requester takes a streamed reply
+
+    uint32_t publisher = 0;
+    uint64_t sequence = 0;
+    bool packed = false;
+    bool more = false;
+    bool stream = false;
+    std::chrono::milliseconds timeout{0};  // requester's, on stream requests
+
+    uint8_t flags() const;
+    // Payloads without any of it go out without a metadata frame
+    bool empty() const { return sequence == 0 && flags() == 0 && timeout.count() == 0; }
+
+    zmq::message_t encode() const;
+};
+
+bool is_meta_frame(const zmq::message_t& frame);
+
+// Fills meta from a metadata frame; returns false, leaving meta alone, for
+// any other frame
+bool read_meta(const zmq::message_t& frame, payload_meta& meta);
+
+// Metadata for frames[index], read from the frame right after it
+payload_meta meta_after(const std::vector<zmq::message_t>& frames, size_t index);
+
+}  // namespace curious::core
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <server/server.h>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+namespace curious::core {
+
+/**
+ * @brief One well-known meeting point for publishers and subscribers.
+ *
+ * Publishers of topics configured with "broker": true connect their PUB
+ * socket to the broker's XSUB frontend; subscribers connect to its XPUB
+ * backend. Nobody needs to know where anyone else lives, and a message
+ * is fanned out to N subscribers once, by the broker, rather than by
+ * every publisher. Subscriptions travel upstream, so publishers still
+ * filter at the source.
+ *
+ * Forwarding is a single loop (it keeps each publisher's order); the
+ * socket I/O and fan-out run on the context's I/O threads, sized by
+ * broker.io_threads. Along the way the loop counts messages, bytes and
+ * subscribers per topic and logs them every broker.stats_interval_ms.
+ */
+class pubsub_broker : public server {
+public:
+    pubsub_broker(const server_config& config, const std::string& serverName);
+
+    void run_loop() override;
+
+private:
+    struct topic_stats {
+        uint64_t messages = 0;
+        uint64_t bytes = 0;
+        uint64_t intervalMessages = 0;
+        uint64_t intervalBytes = 0;
+    };
+
+    void _forward_messages(zmq::socket_t& frontend, zmq::socket_t& backend);
+    void _forward_subscriptions(zmq::socket_t& backend, zmq::socket_t& frontend);
+    void _log_stats(std::chrono::steady_clock::duration interval);
+
+    std::unordered_map<std::string, topic_stats, topic_hash, std::equal_to<>> _topics;
+    std::unordered_map<std::string, int64_t> _subscribers;  // filter -> live subscriptions
+    std::vector<zmq::message_t> _frames;
+};
+
+}  // namespace curious::core
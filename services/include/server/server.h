@@ -5,16 +5,28 @@
 #include <thread>
 #include <atomic>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
+#include <queue>
+#include <vector>
 #include <mutex>
 #include <future>
 #include <functional>
 #include <chrono>
 #include <network/network_message.h>
+#include <network/message_view.h>
 #include <server/server_config.h>
+#include <server/dispatch_pool.h>
+#include <server/mpsc_queue.h>
+#include <server/bounded_queue.h>
 #include <server/listener.h>
+#include <server/task.h>
 #include <base/logger.h>
 
+namespace curious::net {
+class reply;
+}
+
 namespace curious::core {
 
 enum class ActionType {
@@ -32,30 +44,123 @@ public:
     void stop();
     virtual void run_loop() {}
 
+    // Every request carries its own timeout; a request that gets no reply in
+    // time completes with nullptr. kDefaultTimeout means the configured
+    // messaging.request_timeout_ms (30 s unless set).
+    static constexpr std::chrono::milliseconds kDefaultTimeout{0};
+
     // Synchronous messaging
+    // With "publish": {"mode": "async"} the message is serialized later on the
+    // sender thread, so it must not be modified after publish() returns.
     void publish(std::shared_ptr<curious::net::network_message> msg, const std::string& topic);
     void request(std::shared_ptr<curious::net::network_message> req, const std::string& topic, 
                 std::shared_ptr<listener> callbackListener = nullptr, void* closure = nullptr, 
-                bool waitForReply = false);
+                bool waitForReply = false, std::chrono::milliseconds timeout = kDefaultTimeout);
+    // Same as above for a topic interned once with topic_id_of(); skips the
+    // topic lookup entirely. Exact routes only: an id of a bus pattern such
+    // as "BUS.*" names no concrete topic, so publish on a bus by name.
+    void publish(std::shared_ptr<curious::net::network_message> msg, topic_id topic);
+    void request(std::shared_ptr<curious::net::network_message> req, topic_id topic, 
+                std::shared_ptr<listener> callbackListener = nullptr, void* closure = nullptr, 
+                bool waitForReply = false, std::chrono::milliseconds timeout = kDefaultTimeout);
+    // May be called from any thread, long after on_request returned, and in
+    // any order relative to other requests; routing uses the request's reply token.
     void reply(std::shared_ptr<curious::net::network_message> req, 
               std::shared_ptr<curious::net::network_message> resp, 
               const std::string& topic, void* closure = nullptr);
+    // Streamed reply: sends one chunk of the answer, each a reply message of
+    // its own, and ends the stream with last = true. Only for requests whose
+    // getStreamReply() is set (sent with request_stream); chunks from one
+    // thread arrive in order.
+    void reply_chunk(std::shared_ptr<curious::net::network_message> req,
+                     std::shared_ptr<curious::net::network_message> chunk,
+                     const std::string& topic, bool last, void* closure = nullptr);
 
     // Asynchronous messaging
     std::future<std::shared_ptr<curious::net::network_message>> 
-    request_async(std::shared_ptr<curious::net::network_message> req, const std::string& topic);
+    request_async(std::shared_ptr<curious::net::network_message> req, const std::string& topic,
+                  std::chrono::milliseconds timeout = kDefaultTimeout);
     
     void request_async(std::shared_ptr<curious::net::network_message> req, const std::string& topic,
-                      std::function<void(std::shared_ptr<curious::net::network_message>)> callback);
+                      std::function<void(std::shared_ptr<curious::net::network_message>)> callback,
+                      std::chrono::milliseconds timeout = kDefaultTimeout);
+
+    std::future<std::shared_ptr<curious::net::network_message>> 
+    request_async(std::shared_ptr<curious::net::network_message> req, topic_id topic,
+                  std::chrono::milliseconds timeout = kDefaultTimeout);
+
+    void request_async(std::shared_ptr<curious::net::network_message> req, topic_id topic,
+                      std::function<void(std::shared_ptr<curious::net::network_message>)> callback,
+                      std::chrono::milliseconds timeout = kDefaultTimeout);
+
+    // Pipelined messaging: every request goes out in one multipart message
+    // on the topic's requester socket, so N small requests cost one send and
+    // one ROUTER receive instead of N. Each element still completes on its
+    // own, with its reply or nullptr on timeout or failure, in whatever
+    // order the replier answers.
+    std::vector<std::future<std::shared_ptr<curious::net::network_message>>>
+    request_batch_async(std::vector<std::shared_ptr<curious::net::network_message>> reqs, const std::string& topic,
+                        std::chrono::milliseconds timeout = kDefaultTimeout);
+
+    std::vector<std::future<std::shared_ptr<curious::net::network_message>>>
+    request_batch_async(std::vector<std::shared_ptr<curious::net::network_message>> reqs, topic_id topic,
+                        std::chrono::milliseconds timeout = kDefaultTimeout);
+
+    // callback(index, reply) runs once per element; index is its position in reqs
+    void request_batch_async(std::vector<std::shared_ptr<curious::net::network_message>> reqs, topic_id topic,
+                             std::function<void(size_t, std::shared_ptr<curious::net::network_message>)> callback,
+                             std::chrono::milliseconds timeout = kDefaultTimeout);
+
+    // Streamed messaging: asks the replier to answer in bounded chunks, so a
+    // large list needs neither one huge frame nor a full decode before the
+    // first item is usable. callback(chunk, last) runs once per chunk on the
+    // topic's dispatch lane, in order; a replier that answers with plain
+    // reply() yields a single call with last set. The timeout bounds the gap
+    // between chunks, and on expiry callback(nullptr, true) ends the stream.
+    void request_stream(std::shared_ptr<curious::net::network_message> req, const std::string& topic,
+                        std::function<void(std::shared_ptr<curious::net::network_message>, bool)> callback,
+                        std::chrono::milliseconds timeout = kDefaultTimeout);
+    void request_stream(std::shared_ptr<curious::net::network_message> req, topic_id topic,
+                        std::function<void(std::shared_ptr<curious::net::network_message>, bool)> callback,
+                        std::chrono::milliseconds timeout = kDefaultTimeout);
+
+    // Coroutine messaging: inside a task, `auto resp = co_await co_request(req, topic);`
+    // suspends until the reply arrives (nullptr on timeout or failure) and
+    // is resumed by the reactor, on the thread that would have run on_reply.
+    // No thread blocks and nothing is allocated per call beyond the request
+    // itself. Requests still in flight when the server stops resume on the
+    // thread calling stop(): with their reply if it had already arrived,
+    // otherwise with nullptr.
+    class request_awaiter;
+    request_awaiter co_request(std::shared_ptr<curious::net::network_message> req, const std::string& topic,
+                               std::chrono::milliseconds timeout = kDefaultTimeout);
+    request_awaiter co_request(std::shared_ptr<curious::net::network_message> req, topic_id topic,
+                               std::chrono::milliseconds timeout = kDefaultTimeout);
+
+    // Dense id of a configured topic (kInvalidTopicId if unknown); stable for
+    // the server's lifetime, so callers can look it up once and keep it
+    topic_id topic_id_of(const std::string& topic) const;
 
     // Connection management
     void listen(const std::string& topic);
+    // topic may be a bus pattern such as "MARKET.*" to receive every topic on
+    // that bus. Both may be called at any time from any thread.
     void subscribe(const std::string& topic);
+    void unsubscribe(const std::string& topic);
 
     // Event handlers (override in derived classes)
     virtual void on_request(std::shared_ptr<curious::net::network_message> req);
     virtual void on_reply(std::shared_ptr<curious::net::network_message> resp);
     virtual void on_message(std::shared_ptr<curious::net::network_message> msg);
+    // Called instead of on_message for topics configured with "views": true.
+    // The default materializes the view and forwards it like any other message.
+    virtual void on_message_view(std::shared_ptr<curious::net::message_view> msg);
+    // Called on the topic's dispatch lane, ahead of the message that exposed
+    // it, when a subscribed topic's sequence skips (messages were lost, e.g.
+    // dropped at a PUB high-water mark) or goes backwards (the publisher
+    // restarted). The default requests the topic's configured snapshot; its
+    // reply arrives through on_reply.
+    virtual void on_sequence_gap(const std::string& topic, uint64_t expected, uint64_t received);
 
 protected:
     // Configuration and context
@@ -65,48 +170,195 @@ protected:
     // Threading
     std::atomic<bool> _running;
     std::thread _listenerThread;
-    std::mutex _socketMutex;
+    std::unique_ptr<dispatch_pool> _dispatchPool;  // null when callbacks run on _listenerThread
+
+    // Where a publish goes, resolved once from the config's route table;
+    // only topics on a shared bus carry their own name, exact routes reuse
+    // the configured one
+    struct PublishTarget {
+        topic_id id = kInvalidTopicId;
+        const messaging_endpoint* route = nullptr;
+        std::string busTopic;
+        const std::string& topic() const { return busTopic.empty() ? route->topic : busTopic; }
+    };
+    struct OutboundPublish {
+        PublishTarget target;
+        zmq::message_t frame;
+        uint64_t sequence = 0;  // sent in the metadata frame when set
+        bool packed = false;    // frame is packed; flagged to the receiver
+    };
+
+    // Reactor wakeup: other threads queue work in _pendingTasks (or encoded
+    // publishes in _outboundPublishes) and poke the listener through an
+    // inproc PAIR so it returns from zmq::poll immediately. Only the producer
+    // that flips _wakeupPending sends, so a busy listener costs producers
+    // nothing but the queue push.
+    zmq::socket_t _wakeupSender;
+    zmq::socket_t _wakeupReceiver;
+    std::mutex _wakeupMutex;  // guards _wakeupSender, taken only on idle -> busy
+    std::atomic<bool> _wakeupPending{false};
+    mpsc_queue<std::function<void()>> _pendingTasks;
+    mpsc_queue<OutboundPublish> _outboundPublishes;
+
+    // Async publish mode: publish() only queues the message; _senderThread
+    // serializes and sends in batches and owns the PUB sockets. The sender
+    // sleeps on _publishSignal, which producers bump only while it is idle.
+    struct QueuedPublish {
+        std::shared_ptr<curious::net::network_message> msg;
+        PublishTarget target;
+    };
+    std::unique_ptr<bounded_queue<QueuedPublish>> _publishQueue;  // null in inline mode; lives until ~server
+    std::thread _senderThread;
+    std::atomic<bool> _senderRunning{false};
+    std::atomic<bool> _senderIdle{false};
+    std::atomic<uint32_t> _publishSignal{0};
+    std::atomic<size_t> _droppedPublishes{0};
+    std::atomic<size_t> _sequenceGaps{0};
+
+    // Topics with a snapshot request outstanding, so a burst of gaps costs one
+    std::mutex _resyncMutex;
+    std::unordered_set<std::string> _resyncInFlight;
     
-    // Socket management
-    std::unordered_map<std::string, zmq::socket_t> _pubSockets;
-    std::unordered_map<std::string, zmq::socket_t> _subSockets;
-    std::unordered_map<std::string, zmq::socket_t> _reqSockets;
-    std::unordered_map<std::string, zmq::socket_t> _repSockets;
-    std::unordered_map<std::string, bool> _reqSocketReady;
+    // Socket management; every socket is owned by _listenerThread, except
+    // _pubSockets, which belong to _senderThread in async publish mode.
+    // PUB and SUB sockets are per endpoint, so topics on a shared bus use one
+    // socket pair. Publishers and requesters find their socket by config
+    // topic id, indexing flat tables sized to the configured topic count.
+    struct SubscriberSocket {
+        zmq::socket_t socket;
+        size_t drainBudget = 1;
+        // Exact topics delivered from this socket, mapped to whether they
+        // arrive as message views
+        std::unordered_map<std::string, bool, topic_hash, std::equal_to<>> topics;
+        // Bus patterns; a match is dispatched under the pattern itself
+        struct PrefixSubscription {
+            std::string prefix;   // pattern without the trailing '*'
+            std::string pattern;
+            bool views = false;
+        };
+        std::vector<PrefixSubscription> prefixes;
+        // Last sequence seen per received topic and publisher id, for gap detection
+        std::unordered_map<std::string, std::unordered_map<uint32_t, uint64_t>, topic_hash, std::equal_to<>> sequences;
+    };
+    std::unordered_map<std::string, zmq::socket_t> _pubSockets;  // keyed by endpoint
+    std::vector<zmq::socket_t*> _pubRoutes;  // by topic_id -> entry in _pubSockets, null until first use
+    // Last sequence stamped per published topic, by topic_id for exact routes
+    // and by name for topics on a bus; touched only by whichever thread
+    // sends publishes
+    std::vector<uint64_t> _publishSequences;
+    uint32_t _publisherId = 0;  // random per server, sent with every sequence
+    std::unordered_map<std::string, uint64_t> _busPublishSequences;
+    std::unordered_map<std::string, SubscriberSocket> _subSockets;  // keyed by connect endpoint
+    std::unordered_map<std::string, std::string> _subscriptions;  // subscribed topic/pattern -> _subSockets key
+    std::vector<zmq::socket_t> _reqSockets;  // DEALER by topic_id, unopened until first request
+    std::vector<topic_id> _openRequesters;   // ids with an open DEALER, for the poll set
+    std::unordered_map<std::string, zmq::socket_t> _repSockets;  // ROUTER, one per listened topic
+    std::unordered_map<std::string, size_t> _drainBudgets;  // ROUTER sockets, keyed by topic
     
-    // Request-reply mapping
-    std::unordered_map<void*, zmq::socket_t*> _requestReplySocketMap;
+    // Deadlines live in min-heaps next to the maps they expire. Answering
+    // leaves the heap entry behind; it is skipped when it reaches the top
+    // and its key is gone, so expiry costs O(expired), not O(outstanding).
+    using Deadline = std::chrono::steady_clock::time_point;
+    template <typename Key>
+    using DeadlineHeap = std::priority_queue<std::pair<Deadline, Key>, std::vector<std::pair<Deadline, Key>>, std::greater<>>;
+
+    // Reply routing: the ROUTER socket and client envelope of every received
+    // request that has not been answered yet, keyed by the reply token stamped
+    // on the request. Lets reply() arrive from any thread, in any order.
+    struct ReplyRoute {
+        zmq::socket_t* socket = nullptr;
+        std::vector<zmq::message_t> envelope;  // empty for batch members
+        uint64_t batch = 0;                     // _replyBatches key, 0 if sent alone
+        bool stream = false;                    // requester takes reply_chunk()s
+        std::chrono::milliseconds timeout{0};   // requester's for streams, else the configured one
+        Deadline deadline;                      // pushed back by every chunk sent
+    };
+    uint64_t _replyTokenCounter = 0;
+    std::unordered_map<uint64_t, ReplyRoute> _replyRoutes;
+    // A request batch shares one envelope. Replies collect in `ready` and
+    // go out together once per reactor pass; the batch is dropped when its
+    // last member is answered, expired or never dispatched.
+    struct ReplyBatch {
+        zmq::socket_t* socket = nullptr;
+        std::vector<zmq::message_t> envelope;
+        size_t outstanding = 0;
+        std::vector<zmq::message_t> ready;
+    };
+    uint64_t _replyBatchCounter = 0;
+    std::unordered_map<uint64_t, ReplyBatch> _replyBatches;
+    std::vector<uint64_t> _dirtyReplyBatches;  // batches touched since the last flush
+    DeadlineHeap<uint64_t> _replyRouteDeadlines;
     
     // Request tracking
     std::atomic<int> _requestCounter;
     struct PendingRequestInfo {
         std::shared_ptr<listener> callback;
         void* closure;
-        std::string topic;
-        std::chrono::steady_clock::time_point timestamp;
+        topic_id topic;
+        Deadline deadline;
+        // Nonzero for streamed replies: how long to wait for the next chunk
+        std::chrono::milliseconds streamTimeout{0};
     };
     std::unordered_map<int, PendingRequestInfo> _pendingRequests;
+    DeadlineHeap<int> _requestDeadlines;
     std::string _serverName;
 
+    // Applies the config's transport tuning, with the route's own
+    // high-water marks when it sets them; call before bind/connect
+    void _apply_socket_options(zmq::socket_t& socket, const messaging_endpoint* route = nullptr) const;
+
 private:
     // Core messaging implementations
-    void _doPublish(std::shared_ptr<curious::net::network_message> msg, const std::string& topic);
-    void _doRequest(std::shared_ptr<curious::net::network_message> req, const std::string& topic, 
-                   std::shared_ptr<listener> callbackListener, void* closure, bool waitForReply);
+    void _doPublish(std::shared_ptr<curious::net::network_message> msg, PublishTarget target);
+    void _doRequest(std::shared_ptr<curious::net::network_message> req, topic_id topic, 
+                   std::shared_ptr<listener> callbackListener, void* closure, bool waitForReply,
+                   std::chrono::milliseconds timeout);
+    void _doRequestBatch(std::vector<std::shared_ptr<curious::net::network_message>> reqs, topic_id topic,
+                         std::vector<std::shared_ptr<listener>> listeners, std::chrono::milliseconds timeout);
+    zmq::socket_t* _requester_socket(topic_id topic, const messaging_endpoint& route);
+    std::chrono::milliseconds _effective_timeout(std::chrono::milliseconds timeout) const;
     void _doReply(std::shared_ptr<curious::net::network_message> req, 
                  std::shared_ptr<curious::net::network_message> resp, 
-                 const std::string& topic, void* closure);
+                 const std::string& topic, void* closure, bool last);
 
     // Network loop and handlers
     void _listener_loop();
-    void _handle_subscriber_messages();
-    void _handle_incoming_requests();
-    void _handle_request_replies();
+    void _handle_subscriber_messages(SubscriberSocket& subscriber, size_t budget);
+    void _handle_incoming_requests(const std::string& topic, zmq::socket_t& socket, size_t budget);
+    void _handle_request_replies(topic_id topic, zmq::socket_t& socket, size_t budget);
     void _cleanup_expired_requests();
+
+    // Reactor helpers
+    void _post(std::function<void()> task);
+    void _wakeup();
+    void _run_pending_tasks();
+    void _flush_outbound_publishes();
+    void _release_reply_route(std::unordered_map<uint64_t, ReplyRoute>::iterator it);
+    void _flush_reply_batches();
+    void _send_publish(OutboundPublish& outbound);
+    zmq::socket_t* _pub_socket(const PublishTarget& target);
+    uint64_t _stamp_sequence(const PublishTarget& target, uint64_t explicitSequence);
+    void _check_sequence(SubscriberSocket& subscriber, std::string_view frameTopic,
+                         const std::string& topicKey, uint32_t publisher, uint64_t sequence);
+    void _request_snapshot(const std::string& topic);
+    void _enqueue_publish(std::shared_ptr<curious::net::network_message> msg, PublishTarget target);
+    void _sender_loop();
+    size_t _send_publish_batch(size_t maxMessages);
+    void _wake_sender();
+    std::chrono::milliseconds _next_poll_timeout() const;
+    // Runs callback on the topic's lane. Message traffic is dropped when the
+    // lane is full; completions and other control callbacks pass
+    // droppable = false, because someone is waiting on them.
+    bool _dispatch(const std::string& topic, std::function<void()> callback, bool droppable = true);
     
     // Utility functions
-    std::shared_ptr<curious::net::network_message> _deserialize_message(const zmq::message_t& frame);
+    std::shared_ptr<curious::net::network_message> _deserialize_message(zmq::message_t&& frame, bool packed = false);
+    std::shared_ptr<curious::net::message_view> _deserialize_view(zmq::message_t&& frame, bool packed = false);
+    topic_id _resolve_route(const std::string& topic) const;
+    const messaging_endpoint* _route_for_id(topic_id topic) const;
     void _activate_endpoint(messaging_endpoint endpointInfo, ActionType actionType);
+    void _add_subscription(const messaging_endpoint& endpointInfo, const std::string& connectEndpoint);
+    void _remove_subscription(const std::string& topic);
     
     // Logging
     void _setup_console_logger();
@@ -115,6 +367,41 @@ private:
     // Forward declarations for helper classes
     class promise_listener;
     class function_listener;
+    class stream_listener;
+};
+
+// The awaiter lives in the awaiting coroutine's frame and is itself the
+// request's listener, referenced without ownership, so awaiting a request
+// costs no promise, shared state or extra allocation.
+class server::request_awaiter : public listener {
+public:
+    request_awaiter(server& owner, std::shared_ptr<curious::net::network_message> req, topic_id topic,
+                    std::chrono::milliseconds timeout)
+        : _server(owner), _request(std::move(req)), _topic(topic), _timeout(timeout) {}
+
+    request_awaiter(const request_awaiter&) = delete;
+    request_awaiter& operator=(const request_awaiter&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> awaiting);
+    std::shared_ptr<curious::net::reply> await_resume();
+
+    void on_reply(std::shared_ptr<curious::net::network_message> response) override {
+        _response = std::move(response);
+        _awaiting.resume();
+    }
+
+    // Only replies are routed to request listeners
+    void on_request(std::shared_ptr<curious::net::network_message> req) override {}
+    void on_message(std::shared_ptr<curious::net::network_message> msg) override {}
+
+private:
+    server& _server;
+    std::shared_ptr<curious::net::network_message> _request;
+    topic_id _topic;
+    std::chrono::milliseconds _timeout;
+    std::coroutine_handle<> _awaiting;
+    std::shared_ptr<curious::net::network_message> _response;
 };
 
 
@@ -157,4 +444,30 @@ public:
     void on_message(std::shared_ptr<curious::net::network_message> msg) override {}
 };
 
+class server::stream_listener : public listener {
+private:
+    std::function<void(std::shared_ptr<curious::net::network_message>, bool)> _callback;
+
+public:
+    explicit stream_listener(std::function<void(std::shared_ptr<curious::net::network_message>, bool)> callback)
+        : _callback(std::move(callback)) {}
+
+    void on_reply_chunk(std::shared_ptr<curious::net::network_message> chunk) override {
+        if (_callback) {
+            _callback(chunk, false);
+        }
+    }
+
+    // The last chunk, a whole unstreamed reply, or nullptr on timeout
+    void on_reply(std::shared_ptr<curious::net::network_message> response) override {
+        if (_callback) {
+            _callback(response, true);
+        }
+    }
+
+    // Implement required pure virtual methods with empty implementations
+    void on_request(std::shared_ptr<curious::net::network_message> req) override {}
+    void on_message(std::shared_ptr<curious::net::network_message> msg) override {}
+};
+
 }  // namespace curious::core
\ No newline at end of file
@@ -1,19 +1,93 @@
 #pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+// Lets topic-keyed hash containers be probed with a string_view (e.g. a
+// received topic frame) without building a std::string first
+struct topic_hash {
+    using is_transparent = void;
+    size_t operator()(std::string_view topic) const { return std::hash<std::string_view>{}(topic); }
+};
+
 enum class EndpointType {
     TCP,
     IPC,
     UNKNOWN
 };
 
+// What publish() does when the async publish queue is full
+enum class PublishBackpressure {
+    Block,       // caller spins until the sender thread frees a slot
+    DropOldest,  // evict the oldest queued message to make room
+    DropNewest   // discard the message being published
+};
+
+// Dense id of a configured topic: its position in the endpoint list,
+// fixed at load so hot paths can index flat tables instead of hashing
+using topic_id = uint32_t;
+constexpr topic_id kInvalidTopicId = std::numeric_limits<topic_id>::max();
+
+// A topic ending in '*' (e.g. "MARKET.*") is a shared bus: every topic with
+// that prefix uses its endpoint, over one PUB and one SUB socket, and
+// subscribers filter by topic prefix.
 struct messaging_endpoint {
     std::string topic;
     std::string endpoint;
     EndpointType type = EndpointType::UNKNOWN;
+    size_t drainBudget = 0;  // max messages read from this topic's socket per wakeup
+    size_t maxQueueDepth = 0;  // max callbacks waiting in the dispatch pool for this topic
+    bool views = false;  // subscribers get lazy message views (on_message_view) instead of decoded objects
+    // Where a subscriber that detects a sequence gap on this topic asks for
+    // a fresh snapshot: a request message type name (e.g.
+    // "YoutubeVideoSnapshotRequest") sent to snapshotTopic. Empty: no resync.
+    std::string snapshotTopic;
+    std::string snapshotRequest;
+    // Pub/sub goes through the broker instead of a publisher-bound endpoint:
+    // publishers connect to its frontend, subscribers to its backend
+    bool viaBroker = false;
+    // High-water marks for this topic's sockets (0 = unbounded); -1 uses
+    // the transport defaults
+    int sndHwm = -1;
+    int rcvHwm = -1;
+    // "compression": "packed" sends this topic's payloads (publishes,
+    // requests and replies) in Cap'n Proto packed encoding. Only the sender
+    // reads it: the metadata frame marks packed payloads, so receivers take
+    // either form and peers can switch independently.
+    bool packed = false;
+};
+
+// ZeroMQ context and socket tuning from the "transport" section. Negative
+// values leave the libzmq / kernel default alone.
+struct transport_options {
+    int ioThreads = 1;           // context I/O threads
+    int sndHwm = 1000;           // messages queued per peer before PUB drops / others block; 0 = unbounded
+    int rcvHwm = 1000;
+    int sndBuf = -1;             // kernel SO_SNDBUF / SO_RCVBUF, bytes
+    int rcvBuf = -1;
+    int tcpKeepalive = -1;       // 1 enables SO_KEEPALIVE; idle/interval in seconds
+    int tcpKeepaliveIdle = -1;
+    int tcpKeepaliveIntvl = -1;
+    int tcpKeepaliveCnt = -1;
+    bool immediate = false;      // connecting sockets queue only to completed connections
+    uint64_t affinity = 0;       // bitmask of I/O threads new connections use; 0 = any
 };
 
+// The address peers connect to for an endpoint the owner binds; a wildcard
+// interface ("tcp://*:5555") means this host
+inline std::string to_connect_endpoint(std::string endpoint) {
+    if (auto star = endpoint.find('*'); star != std::string::npos) {
+        endpoint.replace(star, 1, "127.0.0.1");
+    }
+    return endpoint;
+}
+
 class server_config {
 public:
     explicit server_config(const std::string& configPath);
@@ -23,7 +97,40 @@ public:
     std::string get_log_file_path() const;
     std::string get_timestamp_format() const;
     const std::vector<messaging_endpoint>& get_messaging_endpoints() const;
+    // Exact topic first, then the longest matching bus prefix; the returned
+    // endpoint carries the requested topic
     const messaging_endpoint get_endpoint_for_topic(const std::string& topic) const;
+    // Same resolution without copying: the configured entry (a bus entry
+    // keeps its "PREFIX*" topic), valid for this config's lifetime, or null
+    const messaging_endpoint* find_route(std::string_view topic) const;
+    // The id of the route find_route would return, or kInvalidTopicId
+    topic_id find_route_id(std::string_view topic) const;
+    // Exact configured topics only (a bus entry by its "PREFIX*" name)
+    topic_id get_topic_id(std::string_view topic) const;
+    const messaging_endpoint& get_route(topic_id id) const;
+    size_t get_topic_count() const;
+    size_t get_dispatch_threads() const;
+    std::chrono::milliseconds get_request_timeout() const;
+    // Dispatch queue limit for topics without their own; per-topic values
+    // are on each messaging_endpoint
+    size_t get_default_max_queue_depth() const;
+    bool get_async_publish() const;
+    size_t get_publish_queue_capacity() const;
+    size_t get_publish_batch_size() const;
+    PublishBackpressure get_publish_backpressure() const;
+    const transport_options& get_transport() const;
+    // Last-value cache: the endpoint it serves subscribers on, and the
+    // configured topics (or "PREFIX*" buses) it caches from upstream
+    const std::string& get_cache_endpoint() const;
+    const std::vector<std::string>& get_cache_topics() const;
+    // Pub/sub broker: the XSUB endpoint publishers connect to, the XPUB
+    // endpoint subscribers connect to (both as the broker binds them), its
+    // I/O thread count (transport.io_threads, at least 2, unless set) and
+    // how often it logs per-topic statistics
+    const std::string& get_broker_frontend() const;
+    const std::string& get_broker_backend() const;
+    int get_broker_io_threads() const;
+    std::chrono::milliseconds get_broker_stats_interval() const;
 
 
 private:
@@ -32,5 +139,23 @@ private:
     std::string _logType;
     std::string _logFilePath;
     std::string _timestampFormat;
+    size_t _defaultDrainBudget;
+    std::chrono::milliseconds _requestTimeout;
+    size_t _dispatchThreads;
+    size_t _defaultMaxQueueDepth;
+    bool _asyncPublish;
+    size_t _publishQueueCapacity;
+    size_t _publishBatchSize;
+    PublishBackpressure _publishBackpressure;
+    transport_options _transport;
+    std::string _cacheEndpoint;
+    std::vector<std::string> _cacheTopics;
+    std::string _brokerFrontend;
+    std::string _brokerBackend;
+    int _brokerIoThreads;
+    std::chrono::milliseconds _brokerStatsInterval;
     std::vector<messaging_endpoint> _messagingEndpoints;
+    // Route table built once at load; indices stay valid when the config is copied
+    std::unordered_map<std::string, topic_id, topic_hash, std::equal_to<>> _routeIndex;
+    std::vector<topic_id> _busRoutes;  // "PREFIX*" entries, longest prefix first
 };
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <server/server_config.h>
+
+namespace curious::core {
+
+// Applies the "transport" tuning to a socket, with the route's own
+// high-water marks when it sets them. Must run before bind/connect:
+// libzmq reads most of these only when a connection is set up.
+void apply_socket_options(zmq::socket_t& socket, const transport_options& transport,
+                          const messaging_endpoint* route = nullptr);
+
+}  // namespace curious::core
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace curious::core {
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+// Runs whoever co_awaited the finished task, or frees a detached one
+template <typename Promise>
+struct final_awaiter {
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        auto& promise = handle.promise();
+        if (promise.continuation) {
+            return promise.continuation;
+        }
+        if (promise.detached) {
+            handle.destroy();
+        }
+        return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct promise_base {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr exception;
+    bool detached = false;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+};
+
+template <typename T>
+struct task_promise : promise_base {
+    std::optional<T> value;
+
+    task<T> get_return_object() noexcept;
+    final_awaiter<task_promise> final_suspend() const noexcept { return {}; }
+
+    template <typename U>
+    void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+
+    T take() {
+        if (exception) std::rethrow_exception(exception);
+        return std::move(*value);
+    }
+};
+
+template <>
+struct task_promise<void> : promise_base {
+    task<void> get_return_object() noexcept;
+    final_awaiter<task_promise> final_suspend() const noexcept { return {}; }
+
+    void return_void() noexcept {}
+
+    void take() {
+        if (exception) std::rethrow_exception(exception);
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @brief A lazily started coroutine producing a T.
+ *
+ * Nothing runs until the task is co_awaited (the awaiter resumes when it
+ * finishes, with no thread hop of its own) or detach()ed from plain code.
+ * Whichever thread completes the last thing the coroutine awaited keeps
+ * running it; for server::co_request that is the reactor or a dispatch
+ * pool thread, so a task should hand long work elsewhere rather than
+ * hold up other callbacks.
+ */
+template <typename T>
+class task {
+public:
+    using promise_type = detail::task_promise<T>;
+
+    task() = default;
+    explicit task(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+    task(task&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+    task& operator=(task&& other) noexcept {
+        if (this != &other) {
+            if (_handle) _handle.destroy();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+
+    ~task() {
+        if (_handle) _handle.destroy();
+    }
+
+    bool valid() const { return static_cast<bool>(_handle); }
+
+    /// Starts the task and lets it free itself when done. An exception
+    /// escaping a detached task is dropped, so catch inside it.
+    void detach() && {
+        auto handle = std::exchange(_handle, nullptr);
+        handle.promise().detached = true;
+        handle.resume();
+    }
+
+    auto operator co_await() && noexcept {
+        struct awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().take(); }
+        };
+        return awaiter{_handle};
+    }
+
+private:
+    std::coroutine_handle<promise_type> _handle;
+};
+
+namespace detail {
+
+template <typename T>
+task<T> task_promise<T>::get_return_object() noexcept {
+    return task<T>(std::coroutine_handle<task_promise>::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+    return task<void>(std::coroutine_handle<task_promise>::from_promise(*this));
+}
+
+}  // namespace detail
+
+}  // namespace curious::core
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <network/youtube_video.h>
+#include <network/youtube_video_updates.h>
+#include <network/youtube_video_snapshot_response.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace curious::videosd {
+
+/**
+ * @brief The videos the service knows about, versioned by sequence number.
+ *
+ * Readers take an immutable snapshot and may hold it as long as they like.
+ * A writer copies the current map (only pointers; the videos themselves are
+ * shared between snapshots), edits the copy and swaps it in under the next
+ * sequence number, so readers never wait on writers.
+ *
+ * Every change comes back as a delta stamped with that sequence number. A
+ * late joiner loads a snapshot at sequence N and then applies exactly the
+ * deltas after N; merge() does that for a replica kept on the other side.
+ */
+class video_catalog {
+public:
+    using video_ptr = std::shared_ptr<const curious::net::youtube_video>;
+
+    struct snapshot {
+        uint64_t sequence = 0;
+        std::unordered_map<std::string, video_ptr> videos;  // by video id
+    };
+
+    struct delta {
+        uint64_t sequence = 0;  // 0 when nothing changed
+        std::vector<video_ptr> upserts;
+        std::vector<std::string> removals;
+
+        bool empty() const { return upserts.empty() && removals.empty(); }
+    };
+
+    video_catalog();
+
+    std::shared_ptr<const snapshot> current() const;
+
+    // Applies all changes as one version. Upserts identical to what the
+    // catalog already holds, and removals of unknown ids, are left out of
+    // the delta; if nothing is left the version does not advance.
+    delta apply(std::vector<curious::net::youtube_video> upserts, const std::vector<std::string>& removals);
+
+    // Replica side: replaces the contents with a snapshot response, or
+    // applies one update. merge() returns false, changing nothing, when the
+    // update is not the next sequence number; reload a snapshot then.
+    void load(const curious::net::youtube_video_snapshot_response& response);
+    bool merge(const curious::net::youtube_video_updates& update);
+    // A streamed snapshot: chunks collect aside and replace the contents
+    // together when the last one arrives. A chunk of another sequence
+    // starts over, dropping an abandoned stream.
+    void load_chunk(const curious::net::youtube_video_snapshot_response& chunk, bool last);
+
+    // Wire form: an update lists upserted videos and then removals, each a
+    // video carrying only its id. The sequence rides on the message itself.
+    static std::shared_ptr<curious::net::youtube_video_updates> to_updates(const delta& change);
+    static std::shared_ptr<curious::net::youtube_video_snapshot_response> to_snapshot_response(const snapshot& state);
+    // The same in responses of at most maxVideos each, built one at a time
+    // and handed to emit as they are ready. All carry the snapshot's
+    // sequence; an empty catalog is a single empty chunk.
+    using chunk_sink = std::function<void(std::shared_ptr<curious::net::youtube_video_snapshot_response>, bool last)>;
+    static void to_snapshot_chunks(const snapshot& state, size_t maxVideos, const chunk_sink& emit);
+    static bool is_removal(const curious::net::youtube_video& video);
+
+private:
+    std::shared_ptr<const snapshot> _swap(std::shared_ptr<const snapshot> next);
+
+    mutable std::mutex _currentMutex;  // guards the _current pointer only
+    std::mutex _writeMutex;            // one writer at a time
+    std::shared_ptr<const snapshot> _current;
+    std::unique_ptr<snapshot> _loading;  // streamed snapshot in progress; guarded by _writeMutex
+};
+
+}  // namespace curious::videosd
@@ -1,5 +1,9 @@
 #include <server/server.h>
 #include <network/youtube_video_updates.h>
+#include <network/youtube_video_snapshot_request.h>
+#include <network/youtube_video_heartbeat.h>
+#include <videosd/video_catalog.h>
+#include <deque>
 
 namespace curious::videosd {
 
@@ -9,12 +13,25 @@ using namespace curious::net;
 class video_server : public server {
 private:
     std::atomic<bool> shouldPublish{true};
+    video_catalog _catalog;
 
 public:
     using server::server;
 
+    static constexpr const char* kUpdateTopic = "YOUTUBE_VIDEO_UPDATE";
+    static constexpr const char* kSnapshotTopic = "YOUTUBE_VIDEO_SNAPSHOT";
+    // Full state (the catalog size) every tick, so a last-value cache can
+    // serve it; the update topic carries deltas and cannot be cached
+    static constexpr const char* kHeartbeatTopic = "YOUTUBE_VIDEO_HEARTBEAT";
+
     void run_loop() override;
     void publish_loop(const std::string& topic, int intervalMs);
+
+    // Answers YoutubeVideoSnapshotRequest from the current catalog version,
+    // in chunks when the requester asked for a stream
+    void on_request(std::shared_ptr<network_message> req) override;
+
+    const video_catalog& catalog() const { return _catalog; }
     
     bool is_running() const {
         return _running;
@@ -24,6 +41,12 @@ public:
         shouldPublish = false;
         stop();
     }
+
+private:
+    // Stand-in for the real video source: a few new videos per tick, one
+    // retitled, the oldest dropped past a fixed catalog size
+    void _poll_source(int tick, std::deque<std::string>& ids,
+                      std::vector<youtube_video>& upserts, std::vector<std::string>& removals);
 };
 
-} // namespace curious::videosd
\ No newline at end of file
+} // namespace curious::videosd
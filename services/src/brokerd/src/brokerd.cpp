@@ -0,0 +1,29 @@
+
+#include <server/pubsub_broker.h>
+#include <iostream>
+#include <base/logger.h>
+
+using namespace curious::core;
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 2) {
+            std::cerr << "Usage: " << argv[0] << " <config_path>\n";
+            return 1;
+        }
+
+        server_config config(argv[1]);
+        pubsub_broker broker(config, "pubsub_broker");
+
+        LOG_INFO << "[brokerd] Starting pub/sub broker..." << go;
+        LOG_INFO << "[brokerd] Press Ctrl+C to stop" << go;
+
+        broker.start();
+
+    } catch (const std::exception& e) {
+        LOG_ERR << "[brokerd] Error: " << e.what() << go;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+
+#include <server/last_value_cache.h>
+#include <iostream>
+#include <base/logger.h>
+
+using namespace curious::core;
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 2) {
+            std::cerr << "Usage: " << argv[0] << " <config_path>\n";
+            return 1;
+        }
+
+        server_config config(argv[1]);
+        last_value_cache cache(config, "last_value_cache");
+
+        LOG_INFO << "[lvcd] Starting last-value cache..." << go;
+        LOG_INFO << "[lvcd] Press Ctrl+C to stop" << go;
+
+        cache.start();
+
+    } catch (const std::exception& e) {
+        LOG_ERR << "[lvcd] Error: " << e.what() << go;
+        return 1;
+    }
+
+    return 0;
+}
@@ -15,6 +15,11 @@ void network_message::toCapnp(curious::message::NetworkMessage::Builder& builder
     builder.setTopic(_topic);
 }
 
+void network_message::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::NetworkMessage>();
+    toCapnp(builder);
+}
+
 network_message network_message::fromCapnp(const curious::message::NetworkMessage::Reader& reader) {
     network_message obj;
 
@@ -20,6 +20,11 @@ void reply::toCapnp(curious::message::Reply::Builder& builder) const {
 
 }
 
+void reply::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::Reply>();
+    toCapnp(builder);
+}
+
 reply reply::fromCapnp(const curious::message::Reply::Reader& reader) {
     reply obj;
 
@@ -18,6 +18,11 @@ void request::toCapnp(curious::message::Request::Builder& builder) const {
     builder.setReqGeneratedPort(_reqGeneratedPort);
 }
 
+void request::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::Request>();
+    toCapnp(builder);
+}
+
 request request::fromCapnp(const curious::message::Request::Reader& reader) {
     request obj;
 
@@ -22,6 +22,11 @@ void test_reply::toCapnp(curious::message::TestReply::Builder& builder) const {
     builder.setResponseTest(_responseTest);
 }
 
+void test_reply::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::TestReply>();
+    toCapnp(builder);
+}
+
 test_reply test_reply::fromCapnp(const curious::message::TestReply::Reader& reader) {
     test_reply obj;
 
@@ -21,6 +21,11 @@ void test_request::toCapnp(curious::message::TestRequest::Builder& builder) cons
     builder.setAge(_age);
 }
 
+void test_request::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::TestRequest>();
+    toCapnp(builder);
+}
+
 test_request test_request::fromCapnp(const curious::message::TestRequest::Reader& reader) {
     test_request obj;
 
@@ -21,6 +21,11 @@ void youtube_blog::toCapnp(curious::message::YoutubeBlog::Builder& builder) cons
     builder.setContentHtml(_contentHtml);
 }
 
+void youtube_blog::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeBlog>();
+    toCapnp(builder);
+}
+
 youtube_blog youtube_blog::fromCapnp(const curious::message::YoutubeBlog::Reader& reader) {
     youtube_blog obj;
 
@@ -16,6 +16,11 @@ void youtube_blog_heartbeat::toCapnp(curious::message::YoutubeBlogHeartbeat::Bui
     builder.setResourcesCount(_resourcesCount);
 }
 
+void youtube_blog_heartbeat::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeBlogHeartbeat>();
+    toCapnp(builder);
+}
+
 youtube_blog_heartbeat youtube_blog_heartbeat::fromCapnp(const curious::message::YoutubeBlogHeartbeat::Reader& reader) {
     youtube_blog_heartbeat obj;
 
@@ -18,6 +18,11 @@ void youtube_blog_snapshot_request::toCapnp(curious::message::YoutubeBlogSnapsho
     builder.setReqGeneratedPort(_reqGeneratedPort);
 }
 
+void youtube_blog_snapshot_request::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeBlogSnapshotRequest>();
+    toCapnp(builder);
+}
+
 youtube_blog_snapshot_request youtube_blog_snapshot_request::fromCapnp(const curious::message::YoutubeBlogSnapshotRequest::Reader& reader) {
     youtube_blog_snapshot_request obj;
 
@@ -27,6 +27,11 @@ void youtube_blog_snapshot_response::toCapnp(curious::message::YoutubeBlogSnapsh
 
 }
 
+void youtube_blog_snapshot_response::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeBlogSnapshotResponse>();
+    toCapnp(builder);
+}
+
 youtube_blog_snapshot_response youtube_blog_snapshot_response::fromCapnp(const curious::message::YoutubeBlogSnapshotResponse::Reader& reader) {
     youtube_blog_snapshot_response obj;
 
@@ -22,6 +22,11 @@ void youtube_blog_updates::toCapnp(curious::message::YoutubeBlogUpdates::Builder
 
 }
 
+void youtube_blog_updates::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeBlogUpdates>();
+    toCapnp(builder);
+}
+
 youtube_blog_updates youtube_blog_updates::fromCapnp(const curious::message::YoutubeBlogUpdates::Reader& reader) {
     youtube_blog_updates obj;
 
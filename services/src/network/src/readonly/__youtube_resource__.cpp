@@ -19,6 +19,11 @@ void youtube_resource::toCapnp(curious::message::YoutubeResource::Builder& build
     builder.setDescription(_description);
 }
 
+void youtube_resource::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeResource>();
+    toCapnp(builder);
+}
+
 youtube_resource youtube_resource::fromCapnp(const curious::message::YoutubeResource::Reader& reader) {
     youtube_resource obj;
 
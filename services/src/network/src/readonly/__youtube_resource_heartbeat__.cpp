@@ -16,6 +16,11 @@ void youtube_resource_heartbeat::toCapnp(curious::message::YoutubeResourceHeartb
     builder.setResourcesCount(_resourcesCount);
 }
 
+void youtube_resource_heartbeat::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeResourceHeartbeat>();
+    toCapnp(builder);
+}
+
 youtube_resource_heartbeat youtube_resource_heartbeat::fromCapnp(const curious::message::YoutubeResourceHeartbeat::Reader& reader) {
     youtube_resource_heartbeat obj;
 
@@ -18,6 +18,11 @@ void youtube_resource_snapshot_request::toCapnp(curious::message::YoutubeResourc
     builder.setReqGeneratedPort(_reqGeneratedPort);
 }
 
+void youtube_resource_snapshot_request::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeResourceSnapshotRequest>();
+    toCapnp(builder);
+}
+
 youtube_resource_snapshot_request youtube_resource_snapshot_request::fromCapnp(const curious::message::YoutubeResourceSnapshotRequest::Reader& reader) {
     youtube_resource_snapshot_request obj;
 
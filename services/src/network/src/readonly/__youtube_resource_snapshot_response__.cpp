@@ -27,6 +27,11 @@ void youtube_resource_snapshot_response::toCapnp(curious::message::YoutubeResour
 
 }
 
+void youtube_resource_snapshot_response::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeResourceSnapshotResponse>();
+    toCapnp(builder);
+}
+
 youtube_resource_snapshot_response youtube_resource_snapshot_response::fromCapnp(const curious::message::YoutubeResourceSnapshotResponse::Reader& reader) {
     youtube_resource_snapshot_response obj;
 
@@ -22,6 +22,11 @@ void youtube_resource_updates::toCapnp(curious::message::YoutubeResourceUpdates:
 
 }
 
+void youtube_resource_updates::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeResourceUpdates>();
+    toCapnp(builder);
+}
+
 youtube_resource_updates youtube_resource_updates::fromCapnp(const curious::message::YoutubeResourceUpdates::Reader& reader) {
     youtube_resource_updates obj;
 
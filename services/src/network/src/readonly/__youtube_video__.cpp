@@ -22,6 +22,11 @@ void youtube_video::toCapnp(curious::message::YoutubeVideo::Builder& builder) co
     builder.setThumbnailMaxres(_thumbnailMaxres);
 }
 
+void youtube_video::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeVideo>();
+    toCapnp(builder);
+}
+
 youtube_video youtube_video::fromCapnp(const curious::message::YoutubeVideo::Reader& reader) {
     youtube_video obj;
 
@@ -16,6 +16,11 @@ void youtube_video_heartbeat::toCapnp(curious::message::YoutubeVideoHeartbeat::B
     builder.setVideosCount(_videosCount);
 }
 
+void youtube_video_heartbeat::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeVideoHeartbeat>();
+    toCapnp(builder);
+}
+
 youtube_video_heartbeat youtube_video_heartbeat::fromCapnp(const curious::message::YoutubeVideoHeartbeat::Reader& reader) {
     youtube_video_heartbeat obj;
 
@@ -18,6 +18,11 @@ void youtube_video_snapshot_request::toCapnp(curious::message::YoutubeVideoSnaps
     builder.setReqGeneratedPort(_reqGeneratedPort);
 }
 
+void youtube_video_snapshot_request::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeVideoSnapshotRequest>();
+    toCapnp(builder);
+}
+
 youtube_video_snapshot_request youtube_video_snapshot_request::fromCapnp(const curious::message::YoutubeVideoSnapshotRequest::Reader& reader) {
     youtube_video_snapshot_request obj;
 
@@ -27,6 +27,11 @@ void youtube_video_snapshot_response::toCapnp(curious::message::YoutubeVideoSnap
 
 }
 
+void youtube_video_snapshot_response::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeVideoSnapshotResponse>();
+    toCapnp(builder);
+}
+
 youtube_video_snapshot_response youtube_video_snapshot_response::fromCapnp(const curious::message::YoutubeVideoSnapshotResponse::Reader& reader) {
     youtube_video_snapshot_response obj;
 
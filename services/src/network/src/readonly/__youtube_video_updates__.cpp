@@ -22,6 +22,11 @@ void youtube_video_updates::toCapnp(curious::message::YoutubeVideoUpdates::Build
 
 }
 
+void youtube_video_updates::toCapnp(capnp::MessageBuilder& message) const {
+    auto builder = message.initRoot<curious::message::YoutubeVideoUpdates>();
+    toCapnp(builder);
+}
+
 youtube_video_updates youtube_video_updates::fromCapnp(const curious::message::YoutubeVideoUpdates::Reader& reader) {
     youtube_video_updates obj;
 
@@ -5,6 +5,7 @@
 #include <parsers/network/capnp_generator.h>
 #include <parsers/network/cpp_header_generator.h>
 #include <parsers/network/cpp_impl_generator.h>
+#include <parsers/network/cpp_view_generator.h>
 #include <parsers/network/cpp_generator.h>
 
 #include <sstream>
@@ -106,6 +107,9 @@ void BracketSchemaParser::generateAllFiles(const std::string &outputDir) {
     CppImplGenerator impls(messages);
     impls.generate(outputDir);
 
+    CppViewGenerator views(messages);
+    views.generate(outputDir);
+
     parser::CppGenerator generator(messages);
     generator.generateAll(outputDir);
     // other generators will follow here (headers, C++ impl, factory builder)
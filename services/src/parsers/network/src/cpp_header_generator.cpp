@@ -358,6 +358,11 @@ void CppHeaderGenerator::generateAccessors(std::ostringstream& out, const Messag
 void CppHeaderGenerator::generateSerializationFunctions(std::ostringstream& out, const Message& msg) const {
     std::string className = getClassName(msg);
     out << "  void toCapnp(curious::message::" << msg.name << "::Builder& builder) const;\n";
+    if (msg.parent.empty()) {
+        out << "  virtual void toCapnp(capnp::MessageBuilder& message) const;\n";
+    } else {
+        out << "  void toCapnp(capnp::MessageBuilder& message) const override;\n";
+    }
     out << "  static " << className << " fromCapnp(const curious::message::" << msg.name << "::Reader& reader);\n";
     out << "  std::string serialize() const;\n";
     out << "  static " << className << " deserialize(const std::string& data);\n";
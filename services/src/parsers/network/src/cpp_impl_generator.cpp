@@ -65,6 +65,9 @@ void CppImplGenerator::generateSerializationImplementations(std::ostringstream&
     // Generate toCapnp implementation
     generateToCapnpImpl(out, msg, className, allFields);
     
+    // Generate root toCapnp implementation
+    generateToCapnpRootImpl(out, msg, className);
+
     // Generate fromCapnp implementation
     generateFromCapnpImpl(out, msg, className, allFields);
     
@@ -123,6 +126,13 @@ void CppImplGenerator::generateToCapnpImpl(std::ostringstream& out, const Messag
     out << "}\n\n";
 }
 
+void CppImplGenerator::generateToCapnpRootImpl(std::ostringstream& out, const Message& msg, const std::string& className) const {
+    out << "void " << className << "::toCapnp(capnp::MessageBuilder& message) const {\n";
+    out << "    auto builder = message.initRoot<curious::message::" << msg.name << ">();\n";
+    out << "    toCapnp(builder);\n";
+    out << "}\n\n";
+}
+
 void CppImplGenerator::generateFromCapnpImpl(std::ostringstream& out, const Message& msg, 
                                             const std::string& className, const std::vector<Field>& allFields) const {
     out << className << " " << className << "::fromCapnp(const curious::message::" << msg.name << "::Reader& reader) {\n";
@@ -0,0 +1,214 @@
+#include <parsers/network/cpp_view_generator.h>
+#include <parsers/network/utils.h>
+#include <base/logger.h>
+
+#include <fstream>
+#include <filesystem>
+#include <sstream>
+
+using namespace parser;
+using namespace parser::utils;
+using namespace curious::log;
+
+CppViewGenerator::CppViewGenerator(const std::map<std::string, Message>& messages)
+    : messages(messages) {}
+
+void CppViewGenerator::generate(const std::string& outputDir) {
+    std::filesystem::create_directories(outputDir + "/include/network");
+
+    generateBaseView(outputDir);
+
+    for (const auto& [name, msg] : messages) {
+        std::string path = outputDir + "/include/network/" + getViewName(name) + ".h";
+
+        std::vector<Field> allFields;
+        collectAllFields(msg, allFields);
+
+        std::ostringstream full;
+        generateIncludes(full, msg, allFields);
+        generateClass(full, msg, allFields);
+
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            LOG_ERR << "Failed to open file: " << path << go;
+            continue;
+        }
+
+        file << full.str();
+        file.close();
+        LOG_INFO << "Generated view: " << path << go;
+    }
+}
+
+void CppViewGenerator::generateBaseView(const std::string& outputDir) const {
+    std::string path = outputDir + "/include/network/message_view.h";
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG_ERR << "Failed to open file: " << path << go;
+        return;
+    }
+
+    file << "#pragma once\n";
+    file << "#include <messages/network_msg.capnp.h>\n";
+    file << "#include <capnp/message.h>\n";
+    file << "#include <memory>\n";
+    file << "#include <string_view>\n";
+    file << "#include <network/message_type.h>\n";
+    file << "#include <network/network_message.h>\n\n";
+    file << "namespace curious::net {\n\n";
+
+    file << "inline std::string_view toStringView(kj::StringPtr text) {\n";
+    file << "  return std::string_view(text.cStr(), text.size());\n";
+    file << "}\n\n";
+
+    file << "// Read-only access to a received message without copying it out of the\n";
+    file << "// buffer it arrived in. Every view, including views of nested fields,\n";
+    file << "// shares ownership of that buffer, so they stay valid while any is alive.\n";
+    file << "class message_view {\n";
+    file << "protected:\n";
+    file << "  std::shared_ptr<capnp::MessageReader> _message;\n";
+    file << "  message_type _msgType;\n";
+    file << "  kj::StringPtr _topic;\n";
+    file << "public:\n";
+    file << "  message_view(std::shared_ptr<capnp::MessageReader> message, message_type msgType, kj::StringPtr topic)\n";
+    file << "    : _message(std::move(message)), _msgType(msgType), _topic(topic) {}\n";
+    file << "  virtual ~message_view() = default;\n\n";
+    file << "  message_type getMsgType() const { return _msgType; }\n";
+    file << "  std::string_view getTopic() const { return toStringView(_topic); }\n";
+    file << "  const std::shared_ptr<capnp::MessageReader>& getMessage() const { return _message; }\n\n";
+    file << "  // Copies every field into the owning message class\n";
+    file << "  virtual std::shared_ptr<network_message> materialize() const = 0;\n";
+    file << "};\n\n";
+
+    file << "}  // namespace curious::net\n";
+    file.close();
+    LOG_INFO << "Generated view: " << path << go;
+}
+
+void CppViewGenerator::collectAllFields(const Message& msg, std::vector<Field>& allFields) const {
+    if (!msg.parent.empty() && messages.count(msg.parent)) {
+        collectAllFields(messages.at(msg.parent), allFields);
+    }
+    for (const auto& field : msg.fields) {
+        allFields.push_back(field);
+    }
+}
+
+bool CppViewGenerator::isBuiltinType(const std::string& type) const {
+    static const std::set<std::string> builtins = {
+        "int8", "int16", "int32", "int64", "int",
+        "uint8", "uint16", "uint32", "uint64", "uint",
+        "float", "float32", "float64", "double",
+        "bool", "string", "bytes", "Data", "Text", "void", "any"
+    };
+    return builtins.count(type) > 0;
+}
+
+std::string CppViewGenerator::getViewName(const std::string& name) const {
+    return toLowerSnakeCase(name) + "_view";
+}
+
+std::string CppViewGenerator::getAccessorName(const std::string& name) const {
+    std::string field = toCamelCase(name);
+    field[0] = std::toupper(field[0]);
+    return field;
+}
+
+void CppViewGenerator::generateIncludes(std::ostringstream& out, const Message& msg, const std::vector<Field>& allFields) const {
+    std::set<std::string> views;
+    for (const auto& f : allFields) {
+        std::string type = f.type;
+        if (type.starts_with("list<") && type.ends_with(">")) {
+            type = type.substr(5, type.length() - 6);
+        }
+        if (type == "MessageType" || type.starts_with("map<") || type.starts_with("Map<") || isBuiltinType(type)) {
+            continue;
+        }
+        views.insert("network/" + getViewName(type) + ".h");
+    }
+
+    out << "#pragma once\n";
+    out << "#include <messages/network_msg.capnp.h>\n";
+    out << "#include <capnp/message.h>\n";
+    out << "#include <cstddef>\n";
+    out << "#include <cstdint>\n";
+    out << "#include <memory>\n";
+    out << "#include <string_view>\n";
+    out << "#include <network/message_view.h>\n";
+    out << "#include <network/" << toLowerSnakeCase(msg.name) << ".h>\n";
+    for (const auto& h : views) {
+        out << "#include <" << h << ">\n";
+    }
+}
+
+void CppViewGenerator::generateClass(std::ostringstream& out, const Message& msg, const std::vector<Field>& allFields) const {
+    const std::string className = toLowerSnakeCase(msg.name);
+    const std::string viewName = getViewName(msg.name);
+    const std::string readerType = "curious::message::" + msg.name + "::Reader";
+
+    bool hasMsgType = false, hasTopic = false;
+    for (const auto& f : allFields) {
+        hasMsgType = hasMsgType || f.name == "msgType";
+        hasTopic = hasTopic || f.name == "topic";
+    }
+
+    out << "\nnamespace curious::net {\n\n";
+    out << "class " << viewName << " : public message_view {\n";
+    out << "protected:\n";
+    out << "  " << readerType << " _reader;\n";
+    out << "public:\n";
+    out << "  explicit " << viewName << "(std::shared_ptr<capnp::MessageReader> message)\n";
+    out << "    : " << viewName << "(message, message->getRoot<curious::message::" << msg.name << ">()) {}\n\n";
+    out << "  " << viewName << "(std::shared_ptr<capnp::MessageReader> message, " << readerType << " reader)\n";
+    out << "    : message_view(std::move(message), "
+        << (hasMsgType ? "fromCapnpType(reader.getMsgType())" : "message_type::unknown") << ", "
+        << (hasTopic ? "reader.getTopic()" : "kj::StringPtr()") << "),\n";
+    out << "      _reader(reader) {}\n\n";
+
+    for (const auto& f : allFields) {
+        // msgType and topic are read once by message_view
+        if (f.name == "msgType" || f.name == "topic") continue;
+        generateAccessor(out, f);
+    }
+
+    out << "  " << readerType << " getReader() const { return _reader; }\n";
+    out << "  " << className << " toOwned() const { return " << className << "::fromCapnp(_reader); }\n";
+    out << "  std::shared_ptr<network_message> materialize() const override {\n";
+    out << "    return std::make_shared<" << className << ">(toOwned());\n";
+    out << "  }\n";
+    out << "};\n";
+    out << "}  // namespace curious::net\n";
+}
+
+void CppViewGenerator::generateAccessor(std::ostringstream& out, const Field& field) const {
+    const std::string accessor = getAccessorName(field.name);
+
+    if (field.type == "string" || field.type == "Text") {
+        out << "  std::string_view get" << accessor << "() const { return toStringView(_reader.get" << accessor << "()); }\n\n";
+        return;
+    }
+
+    if (field.type.starts_with("list<") && field.type.ends_with(">")) {
+        std::string inner = field.type.substr(5, field.type.length() - 6);
+        if (isBuiltinType(inner)) {
+            out << "  auto get" << accessor << "() const { return _reader.get" << accessor << "(); }\n\n";
+        } else {
+            std::string innerView = getViewName(inner);
+            out << "  size_t get" << accessor << "Count() const { return _reader.get" << accessor << "().size(); }\n";
+            out << "  " << innerView << " get" << accessor << "At(size_t index) const {\n";
+            out << "    return " << innerView << "(_message, _reader.get" << accessor << "()[index]);\n";
+            out << "  }\n\n";
+        }
+        return;
+    }
+
+    if (isBuiltinType(field.type) || field.type.starts_with("map<") || field.type.starts_with("Map<")) {
+        out << "  auto get" << accessor << "() const { return _reader.get" << accessor << "(); }\n\n";
+        return;
+    }
+
+    // Nested message: a view sharing this message's buffer
+    std::string innerView = getViewName(field.type);
+    out << "  " << innerView << " get" << accessor << "() const { return " << innerView
+        << "(_message, _reader.get" << accessor << "()); }\n\n";
+}
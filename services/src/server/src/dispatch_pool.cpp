@@ -0,0 +1,109 @@
+#include <server/dispatch_pool.h>
+#include <base/logger.h>
+
+namespace curious::core {
+
+dispatch_pool::dispatch_pool(size_t threadCount, size_t defaultMaxQueueDepth)
+    : _defaultMaxQueueDepth(defaultMaxQueueDepth) {
+    _workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        _workers.emplace_back(&dispatch_pool::_worker_loop, this);
+    }
+    LOG_INFO << "[dispatch_pool] Started " << threadCount << " worker thread(s)" << go;
+}
+
+dispatch_pool::~dispatch_pool() {
+    stop();
+}
+
+void dispatch_pool::set_max_queue_depth(const std::string& topic, size_t depth) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _queues[topic].maxDepth = depth;
+}
+
+bool dispatch_pool::submit(const std::string& topic, std::function<void()> task, bool bounded) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_stopping) return false;
+
+    auto& queue = _queues[topic];
+    const size_t limit = queue.maxDepth > 0 ? queue.maxDepth : _defaultMaxQueueDepth;
+    if (bounded && queue.tasks.size() >= limit) {
+        return false;
+    }
+
+    queue.tasks.push_back({std::move(task), bounded});
+    // A topic sits in _ready at most once; the worker running it re-queues
+    // it afterwards if more work arrived, which keeps the topic serialized.
+    if (!queue.scheduled) {
+        queue.scheduled = true;
+        _ready.push_back(&queue);
+        _workAvailable.notify_one();
+    }
+    return true;
+}
+
+std::vector<std::function<void()>> dispatch_pool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stopping) return {};
+        _stopping = true;
+    }
+    _workAvailable.notify_all();
+
+    for (auto& worker : _workers) {
+        if (worker.joinable()) worker.join();
+    }
+
+    // The workers are gone, so the queues are ours without the lock
+    std::vector<std::function<void()>> kept;
+    size_t discarded = 0;
+    for (auto& [topic, queue] : _queues) {
+        for (auto& task : queue.tasks) {
+            if (task.bounded) {
+                ++discarded;
+            } else {
+                kept.push_back(std::move(task.run));
+            }
+        }
+        queue.tasks.clear();
+    }
+
+    if (discarded > 0) {
+        LOG_WARN << "[dispatch_pool] Discarded " << discarded << " queued task(s) on stop" << go;
+    }
+    return kept;
+}
+
+void dispatch_pool::_worker_loop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true) {
+        _workAvailable.wait(lock, [this] { return _stopping || !_ready.empty(); });
+        if (_stopping) return;
+
+        topic_queue* queue = _ready.front();
+        _ready.pop_front();
+        auto task = std::move(queue->tasks.front().run);
+        queue->tasks.pop_front();
+
+        lock.unlock();
+        try {
+            task();
+        } catch (const std::exception& e) {
+            LOG_ERR << "[dispatch_pool] Handler threw: " << e.what() << go;
+        } catch (...) {
+            LOG_ERR << "[dispatch_pool] Handler threw an unknown exception" << go;
+        }
+        lock.lock();
+
+        // Back of the line so one busy topic cannot starve the others
+        if (!queue->tasks.empty()) {
+            _ready.push_back(queue);
+            _workAvailable.notify_one();
+        } else {
+            queue->scheduled = false;
+        }
+    }
+}
+
+}  // namespace curious::core
@@ -0,0 +1,39 @@
+#include <server/frame_reader.h>
+#include <capnp/serialize-packed.h>
+#include <cstdint>
+#include <cstring>
+
+namespace curious::core {
+
+frame_reader::frame_reader(zmq::message_t&& frame, bool packed, capnp::ReaderOptions options)
+    : _frame(std::move(frame)) {
+    // Look at the data only after the move: small messages live inside the
+    // zmq_msg_t itself, so their address changes with the owning object.
+    const auto* data = static_cast<const char*>(_frame.data());
+    const size_t size = _frame.size();
+
+    if (packed) {
+        _input = std::make_unique<kj::ArrayInputStream>(
+            kj::arrayPtr(reinterpret_cast<const kj::byte*>(data), size));
+        _reader = std::make_unique<capnp::PackedMessageReader>(*_input, options);
+        return;
+    }
+    const size_t wordCount = size / sizeof(capnp::word);
+
+    const bool aligned = reinterpret_cast<std::uintptr_t>(data) % alignof(capnp::word) == 0 &&
+                         size % sizeof(capnp::word) == 0;
+
+    kj::ArrayPtr<const capnp::word> words;
+    if (aligned) {
+        words = kj::arrayPtr(reinterpret_cast<const capnp::word*>(data), wordCount);
+    } else {
+        _copy = kj::heapArray<capnp::word>((size + sizeof(capnp::word) - 1) / sizeof(capnp::word));
+        std::memset(_copy.begin(), 0, _copy.size() * sizeof(capnp::word));
+        std::memcpy(_copy.begin(), data, size);
+        words = _copy.asPtr();
+    }
+
+    _reader = std::make_unique<capnp::FlatArrayMessageReader>(words, options);
+}
+
+}  // namespace curious::core
@@ -0,0 +1,154 @@
+#include <server/last_value_cache.h>
+#include <server/frame_reader.h>
+#include <server/payload_meta.h>
+#include <network/factory_builder.h>
+#include <set>
+#include <string_view>
+
+namespace curious::core {
+
+namespace {
+// How often the loop looks at _running when no traffic arrives
+constexpr std::chrono::milliseconds kPollInterval{100};
+
+zmq::message_t copy_frame(const zmq::message_t& frame) {
+    zmq::message_t copy;
+    copy.copy(frame);
+    return copy;
+}
+}
+
+last_value_cache::last_value_cache(const server_config& config, const std::string& serverName)
+    : server(config, serverName) {}
+
+void last_value_cache::run_loop() {
+    const std::string& endpoint = _config.get_cache_endpoint();
+    if (endpoint.empty() || _config.get_cache_topics().empty()) {
+        LOG_ERR << "[last_value_cache] No cache endpoint or topics configured" << go;
+        return;
+    }
+
+    zmq::socket_t upstream(*_zmqContext, zmq::socket_type::sub);
+    zmq::socket_t downstream(*_zmqContext, zmq::socket_type::xpub);
+    try {
+        _apply_socket_options(upstream);
+        _apply_socket_options(downstream);
+        upstream.set(zmq::sockopt::linger, 0);
+        downstream.set(zmq::sockopt::linger, 0);
+        downstream.set(zmq::sockopt::xpub_verbose, 1);  // report every subscription, not just the first
+        downstream.bind(endpoint);
+
+        // Same endpoint resolution as server::subscribe
+        std::set<std::string> connected;
+        for (const auto& topic : _config.get_cache_topics()) {
+            const auto route = _config.get_endpoint_for_topic(topic);
+            if (route.endpoint.empty()) {
+                LOG_ERR << "[last_value_cache] No endpoint configured for topic: " << topic << go;
+                continue;
+            }
+            const std::string connectEndpoint =
+                to_connect_endpoint(route.viaBroker ? _config.get_broker_backend() : route.endpoint);
+            if (connected.insert(connectEndpoint).second) {
+                upstream.connect(connectEndpoint);
+            }
+            const bool pattern = topic.back() == '*';
+            upstream.set(zmq::sockopt::subscribe, pattern ? topic.substr(0, topic.size() - 1) : topic);
+            LOG_INFO << "[last_value_cache] Caching topic: " << topic << " from " << connectEndpoint << go;
+        }
+    } catch (const zmq::error_t& e) {
+        LOG_ERR << "[last_value_cache] Failed to set up sockets: " << e.what() << go;
+        return;
+    }
+    LOG_INFO << "[last_value_cache] Serving subscribers at " << endpoint << go;
+
+    std::vector<zmq::message_t> frames;
+    while (_running) {
+        try {
+            zmq::pollitem_t items[] = {
+                {upstream.handle(), 0, ZMQ_POLLIN, 0},
+                {downstream.handle(), 0, ZMQ_POLLIN, 0},
+            };
+            zmq::poll(items, 2, kPollInterval);
+
+            if (items[0].revents & ZMQ_POLLIN) {
+                frames.clear();
+                do {
+                    frames.emplace_back();
+                    if (!upstream.recv(frames.back(), zmq::recv_flags::none)) break;
+                } while (frames.back().more());
+                _on_upstream(frames, downstream);
+            }
+            if (items[1].revents & ZMQ_POLLIN) {
+                zmq::message_t subscription;
+                if (downstream.recv(subscription, zmq::recv_flags::none)) {
+                    _on_subscription(subscription, downstream);
+                }
+            }
+        } catch (const zmq::error_t& e) {
+            if (e.num() == EINTR) continue;
+            LOG_ERR << "[last_value_cache] ZMQ error: " << e.what() << go;
+        } catch (const std::exception& e) {
+            LOG_ERR << "[last_value_cache] Error: " << e.what() << go;
+        }
+    }
+
+    LOG_INFO << "[last_value_cache] Stopped after forwarding " << _forwarded << " messages and replaying "
+             << _replayed << go;
+}
+
+void last_value_cache::_on_upstream(std::vector<zmq::message_t>& frames, zmq::socket_t& downstream) {
+    if (frames.size() < 2) return;
+
+    // Keep [topic][data] and whether the data is packed; the sequence
+    // number only goes out live
+    const bool packed = meta_after(frames, 1).packed;
+
+    const std::string_view topic(static_cast<const char*>(frames[0].data()), frames[0].size());
+    auto topicIt = _cache.find(topic);
+    if (topicIt == _cache.end()) {
+        topicIt = _cache.emplace(std::string(topic), std::map<std::string, std::vector<zmq::message_t>>{}).first;
+    }
+    auto& entry = topicIt->second[_key_of(frames[1], packed)];
+    entry.clear();
+    entry.push_back(copy_frame(frames[0]));
+    entry.push_back(copy_frame(frames[1]));
+    if (packed) entry.push_back(payload_meta{.packed = true}.encode());
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        downstream.send(frames[i], i + 1 < frames.size() ? zmq::send_flags::sndmore : zmq::send_flags::none);
+    }
+    ++_forwarded;
+}
+
+void last_value_cache::_on_subscription(const zmq::message_t& frame, zmq::socket_t& downstream) {
+    // XPUB hands us the filter with a leading 1 (subscribe) or 0 (unsubscribe)
+    if (frame.size() == 0 || static_cast<const uint8_t*>(frame.data())[0] != 1) return;
+    const std::string_view filter(static_cast<const char*>(frame.data()) + 1, frame.size() - 1);
+
+    size_t sent = 0;
+    for (auto it = _cache.lower_bound(filter); it != _cache.end() && it->first.starts_with(filter); ++it) {
+        for (const auto& [key, cached] : it->second) {
+            for (size_t i = 0; i < cached.size(); ++i) {
+                zmq::message_t part = copy_frame(cached[i]);
+                downstream.send(part, i + 1 < cached.size() ? zmq::send_flags::sndmore : zmq::send_flags::none);
+            }
+            ++sent;
+        }
+    }
+    _replayed += sent;
+    LOG_INFO << "[last_value_cache] New subscription to '" << filter << "', replayed " << sent << " cached values" << go;
+}
+
+std::string last_value_cache::_key_of(const zmq::message_t& dataFrame, bool packed) const {
+    if (!_keyOf) return {};
+    try {
+        frame_reader input(copy_frame(dataFrame), packed);
+        auto msg = curious::net::FactoryBuilder::fromCapnp(input.reader());
+        return msg ? _keyOf(*msg) : std::string();
+    } catch (const std::exception& e) {
+        LOG_ERR << "[last_value_cache] Failed to decode message for its key: " << e.what() << go;
+        return {};
+    }
+}
+
+}  // namespace curious::core
@@ -0,0 +1,64 @@
+#include <server/outbound_builder.h>
+#include <kj/array.h>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace curious::core {
+
+namespace {
+// capnp's own default first segment (8 KiB)
+constexpr size_t kDefaultFirstSegmentWords = 1024;
+// Messages bigger than this (8 MiB) are not worth pinning per thread
+constexpr size_t kMaxPooledWords = size_t(1) << 20;
+
+struct thread_arena {
+    kj::Array<capnp::word> segment;
+    std::unordered_map<int, size_t> sizeHints;  // words, keyed by message_type
+    bool inUse = false;
+};
+
+thread_arena& local_arena() {
+    thread_local thread_arena arena;
+    return arena;
+}
+}
+
+outbound_builder::outbound_builder(curious::net::message_type type) : _type(type) {
+    auto& arena = local_arena();
+    auto hintIt = arena.sizeHints.find(static_cast<int>(type));
+    const size_t hint = hintIt != arena.sizeHints.end() ? hintIt->second : kDefaultFirstSegmentWords;
+
+    if (arena.inUse || hint > kMaxPooledWords) {
+        _builder.emplace(static_cast<unsigned int>(hint));
+        return;
+    }
+
+    // The builder requires a zeroed first segment; it re-zeroes what it used
+    // on destruction, so only a freshly grown buffer needs clearing here
+    if (arena.segment.size() < hint) {
+        arena.segment = kj::heapArray<capnp::word>(hint);
+        std::memset(arena.segment.begin(), 0, arena.segment.size() * sizeof(capnp::word));
+    }
+    arena.inUse = true;
+    _pooled = true;
+    _builder.emplace(arena.segment.asPtr());
+}
+
+outbound_builder::~outbound_builder() {
+    size_t used = 0;
+    for (auto segment : _builder->getSegmentsForOutput()) {
+        used += segment.size();
+    }
+
+    auto& arena = local_arena();
+    auto& hint = arena.sizeHints.try_emplace(static_cast<int>(_type), kDefaultFirstSegmentWords).first->second;
+    hint = std::max(hint, used);
+
+    _builder.reset();
+    if (_pooled) {
+        arena.inUse = false;
+    }
+}
+
+}  // namespace curious::core
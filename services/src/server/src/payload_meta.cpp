@@ -0,0 +1,60 @@
+#include <server/payload_meta.h>
+#include <algorithm>
+
+namespace curious::core {
+
+namespace {
+constexpr uint8_t kMetaMarker = 0x0A;
+constexpr size_t kMetaFrameSize = 2 + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+
+void encode_le(uint8_t* bytes, uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i) bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint64_t decode_le(const uint8_t* bytes, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    return value;
+}
+}
+
+uint8_t payload_meta::flags() const {
+    return (packed ? kFlagPacked : 0) | (more ? kFlagMore : 0) | (stream ? kFlagStream : 0);
+}
+
+zmq::message_t payload_meta::encode() const {
+    zmq::message_t frame(kMetaFrameSize);
+    auto* bytes = static_cast<uint8_t*>(frame.data());
+    bytes[0] = kMetaMarker;
+    bytes[1] = flags();
+    encode_le(bytes + 2, publisher, sizeof(uint32_t));
+    encode_le(bytes + 6, sequence, sizeof(uint64_t));
+    encode_le(bytes + 14, static_cast<uint32_t>(std::clamp<int64_t>(timeout.count(), 0, UINT32_MAX)),
+              sizeof(uint32_t));
+    return frame;
+}
+
+bool is_meta_frame(const zmq::message_t& frame) {
+    return frame.size() == kMetaFrameSize && *static_cast<const uint8_t*>(frame.data()) == kMetaMarker;
+}
+
+bool read_meta(const zmq::message_t& frame, payload_meta& meta) {
+    if (!is_meta_frame(frame)) return false;
+    const auto* bytes = static_cast<const uint8_t*>(frame.data());
+    const uint8_t flags = bytes[1];
+    meta.packed = (flags & payload_meta::kFlagPacked) != 0;
+    meta.more = (flags & payload_meta::kFlagMore) != 0;
+    meta.stream = (flags & payload_meta::kFlagStream) != 0;
+    meta.publisher = static_cast<uint32_t>(decode_le(bytes + 2, sizeof(uint32_t)));
+    meta.sequence = decode_le(bytes + 6, sizeof(uint64_t));
+    meta.timeout = std::chrono::milliseconds(decode_le(bytes + 14, sizeof(uint32_t)));
+    return true;
+}
+
+payload_meta meta_after(const std::vector<zmq::message_t>& frames, size_t index) {
+    payload_meta meta;
+    if (index + 1 < frames.size()) read_meta(frames[index + 1], meta);
+    return meta;
+}
+
+}  // namespace curious::core
@@ -0,0 +1,141 @@
+#include <server/pubsub_broker.h>
+#include <string_view>
+
+namespace curious::core {
+
+namespace {
+// How often the loop looks at _running when no traffic arrives
+constexpr std::chrono::milliseconds kPollInterval{100};
+// Messages forwarded per wakeup before subscriptions get a turn
+constexpr size_t kForwardBudget = 256;
+}
+
+pubsub_broker::pubsub_broker(const server_config& config, const std::string& serverName)
+    : server(config, serverName) {
+    // Fan-out happens on the I/O threads, so the broker wants more than one
+    _zmqContext = std::make_unique<zmq::context_t>(_config.get_broker_io_threads());
+}
+
+void pubsub_broker::run_loop() {
+    const std::string& frontendEndpoint = _config.get_broker_frontend();
+    const std::string& backendEndpoint = _config.get_broker_backend();
+    if (frontendEndpoint.empty() || backendEndpoint.empty()) {
+        LOG_ERR << "[pubsub_broker] broker.frontend and broker.backend must both be configured" << go;
+        return;
+    }
+
+    zmq::socket_t frontend(*_zmqContext, zmq::socket_type::xsub);
+    zmq::socket_t backend(*_zmqContext, zmq::socket_type::xpub);
+    try {
+        _apply_socket_options(frontend);
+        _apply_socket_options(backend);
+        frontend.set(zmq::sockopt::linger, 0);
+        backend.set(zmq::sockopt::linger, 0);
+        // Pass every subscribe and unsubscribe up, not just the first and
+        // last per filter, so subscriber counts are exact; publishers count
+        // repeats on one pipe the same way
+        backend.set(zmq::sockopt::xpub_verboser, 1);
+        frontend.bind(frontendEndpoint);
+        backend.bind(backendEndpoint);
+    } catch (const zmq::error_t& e) {
+        LOG_ERR << "[pubsub_broker] Failed to bind: " << e.what() << go;
+        return;
+    }
+    LOG_INFO << "[pubsub_broker] Publishers connect to " << frontendEndpoint << ", subscribers to "
+             << backendEndpoint << " (" << _config.get_broker_io_threads() << " I/O threads)" << go;
+
+    const auto statsInterval = _config.get_broker_stats_interval();
+    auto lastStats = std::chrono::steady_clock::now();
+
+    while (_running) {
+        try {
+            zmq::pollitem_t items[] = {
+                {frontend.handle(), 0, ZMQ_POLLIN, 0},
+                {backend.handle(), 0, ZMQ_POLLIN, 0},
+            };
+            zmq::poll(items, 2, kPollInterval);
+
+            if (items[0].revents & ZMQ_POLLIN) _forward_messages(frontend, backend);
+            if (items[1].revents & ZMQ_POLLIN) _forward_subscriptions(backend, frontend);
+
+            const auto now = std::chrono::steady_clock::now();
+            if (statsInterval > std::chrono::milliseconds::zero() && now - lastStats >= statsInterval) {
+                _log_stats(now - lastStats);
+                lastStats = now;
+            }
+        } catch (const zmq::error_t& e) {
+            if (e.num() == EINTR) continue;
+            LOG_ERR << "[pubsub_broker] ZMQ error: " << e.what() << go;
+        } catch (const std::exception& e) {
+            LOG_ERR << "[pubsub_broker] Error: " << e.what() << go;
+        }
+    }
+
+    _log_stats(std::chrono::steady_clock::now() - lastStats);
+    LOG_INFO << "[pubsub_broker] Stopped" << go;
+}
+
+void pubsub_broker::_forward_messages(zmq::socket_t& frontend, zmq::socket_t& backend) {
+    for (size_t forwarded = 0; forwarded < kForwardBudget; ++forwarded) {
+        _frames.clear();
+        _frames.emplace_back();
+        if (!frontend.recv(_frames.back(), zmq::recv_flags::dontwait)) return;
+        while (_frames.back().more()) {
+            _frames.emplace_back();
+            (void)frontend.recv(_frames.back(), zmq::recv_flags::none);
+        }
+
+        // The first frame is the topic; count before the frames are moved out
+        const std::string_view topic(static_cast<const char*>(_frames[0].data()), _frames[0].size());
+        uint64_t bytes = 0;
+        for (const auto& frame : _frames) bytes += frame.size();
+        auto it = _topics.find(topic);
+        if (it == _topics.end()) it = _topics.emplace(std::string(topic), topic_stats{}).first;
+        auto& stats = it->second;
+        ++stats.messages;
+        ++stats.intervalMessages;
+        stats.bytes += bytes;
+        stats.intervalBytes += bytes;
+
+        for (size_t i = 0; i < _frames.size(); ++i) {
+            backend.send(_frames[i], i + 1 < _frames.size() ? zmq::send_flags::sndmore : zmq::send_flags::none);
+        }
+    }
+}
+
+void pubsub_broker::_forward_subscriptions(zmq::socket_t& backend, zmq::socket_t& frontend) {
+    zmq::message_t subscription;
+    while (backend.recv(subscription, zmq::recv_flags::dontwait)) {
+        // [1|0][filter]: a subscriber joined or left the filter
+        if (subscription.size() > 0) {
+            const auto* data = static_cast<const char*>(subscription.data());
+            const std::string filter(data + 1, subscription.size() - 1);
+            auto& count = _subscribers[filter];
+            count += data[0] == 1 ? 1 : -1;
+            LOG_INFO << "[pubsub_broker] " << (data[0] == 1 ? "Subscribe" : "Unsubscribe") << " '" << filter
+                     << "', " << count << " subscribers" << go;
+            if (count <= 0) _subscribers.erase(filter);
+        }
+        frontend.send(subscription, zmq::send_flags::none);
+    }
+}
+
+void pubsub_broker::_log_stats(std::chrono::steady_clock::duration interval) {
+    const double seconds = std::chrono::duration<double>(interval).count();
+    for (auto& [topic, stats] : _topics) {
+        if (stats.intervalMessages == 0) continue;
+        // A topic reaches everyone holding a filter that prefixes it
+        int64_t subscribers = 0;
+        for (const auto& [filter, count] : _subscribers) {
+            if (topic.starts_with(filter)) subscribers += count;
+        }
+        LOG_INFO << "[pubsub_broker] " << topic << ": " << stats.intervalMessages << " msgs ("
+                 << (seconds > 0 ? stats.intervalMessages / seconds : 0) << " msg/s, "
+                 << (seconds > 0 ? stats.intervalBytes / seconds : 0) << " B/s) to " << subscribers
+                 << " subscribers; " << stats.messages << " msgs, " << stats.bytes << " B total" << go;
+        stats.intervalMessages = 0;
+        stats.intervalBytes = 0;
+    }
+}
+
+}  // namespace curious::core
@@ -1,6 +1,10 @@
 // Complete Fixed server.cpp - All methods included with proper sync_listener
 
 #include <server/server.h>
+#include <server/frame_reader.h>
+#include <server/outbound_builder.h>
+#include <server/payload_meta.h>
+#include <server/socket_options.h>
 #include <network/network_message.h>
 #include <network/factory_builder.h>
 #include <iostream>
@@ -10,11 +14,99 @@
 #include <future>
 #include <capnp/message.h>
 #include <capnp/serialize.h>
+#include <capnp/serialize-packed.h>
 #include <kj/io.h>
 #include <filesystem>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
 
 namespace curious::core {
 
+namespace {
+// How long a synchronous request() waits past its timeout for the reactor's
+// own expiry to report it, before giving up on its own
+constexpr auto kSyncWaitSlack = std::chrono::seconds(1);
+
+// Reads one complete multipart message without blocking; false when nothing is queued
+bool recv_frames(zmq::socket_t& socket, std::vector<zmq::message_t>& frames) {
+    frames.clear();
+    frames.emplace_back();
+    if (!socket.recv(frames.back(), zmq::recv_flags::dontwait)) {
+        frames.clear();
+        return false;
+    }
+    while (frames.back().more()) {
+        frames.emplace_back();
+        (void)socket.recv(frames.back(), zmq::recv_flags::none);
+    }
+    return true;
+}
+
+// Serializes straight into a zmq-owned buffer sized up front, so the only
+// copy is the one writeMessage makes of the builder's segments. The wire
+// format is the same standard framing a VectorOutputStream would produce.
+zmq::message_t encode_frame(capnp::MessageBuilder& builder) {
+    const size_t size = capnp::computeSerializedSizeInWords(builder) * sizeof(capnp::word);
+    zmq::message_t frame(size);
+    kj::ArrayOutputStream out(kj::arrayPtr(static_cast<kj::byte*>(frame.data()), size));
+    capnp::writeMessage(out, builder);
+    return frame;
+}
+
+// Packed encoding drops the zero bytes that fill Cap'n Proto's fixed-width
+// layout (unset fields, pointer padding, short text), typically halving
+// list-heavy messages for one cheap pass. The packed size is only known
+// after writing, so write into a worst-case buffer (a tag byte, a run count
+// and the word itself per word) and hand zmq the used prefix.
+zmq::message_t encode_packed_frame(capnp::MessageBuilder& builder) {
+    const size_t bound = capnp::computeSerializedSizeInWords(builder) * (sizeof(capnp::word) + 2) + sizeof(capnp::word);
+    auto* buffer = static_cast<kj::byte*>(std::malloc(bound));
+    if (buffer == nullptr) throw std::bad_alloc();
+    kj::ArrayOutputStream out(kj::arrayPtr(buffer, bound));
+    try {
+        capnp::writePackedMessage(out, builder);
+    } catch (...) {
+        std::free(buffer);
+        throw;
+    }
+    return zmq::message_t(buffer, out.getArray().size(), [](void* data, void*) { std::free(data); }, nullptr);
+}
+
+zmq::message_t encode_frame(capnp::MessageBuilder& builder, bool packed) {
+    return packed ? encode_packed_frame(builder) : encode_frame(builder);
+}
+
+// Sends a data frame followed by its metadata frame, if it needs one
+void send_payload(zmq::socket_t& socket, zmq::message_t& dataFrame, const payload_meta& meta, zmq::send_flags last) {
+    if (meta.empty()) {
+        socket.send(dataFrame, last);
+        return;
+    }
+    socket.send(dataFrame, zmq::send_flags::sndmore);
+    zmq::message_t metaFrame = meta.encode();
+    socket.send(metaFrame, last);
+}
+
+// Sends a reply's routing envelope, consuming it, or copies of it when more
+// replies will follow on it. Reply ROUTERs set router_mandatory, under which
+// a blocking send waits out a peer at its high-water mark and stalls the
+// reactor, so the envelope goes with dontwait. Once its first frame is
+// accepted the rest of the message cannot block. Returns false when the
+// peer cannot take a message now.
+bool send_envelope(zmq::socket_t& socket, std::vector<zmq::message_t>& envelope, bool consume) {
+    for (auto& part : envelope) {
+        zmq::message_t copy;
+        if (!consume) copy.copy(part);
+        if (!socket.send(consume ? part : copy, zmq::send_flags::sndmore | zmq::send_flags::dontwait)) return false;
+    }
+    return true;
+}
+}
+
 // Helper class for synchronous requests - implements all pure virtual methods
 class sync_listener : public listener {
 private:
@@ -50,7 +142,14 @@ server::server(const server_config& config, const std::string& serverName)
     } else {
         _setup_console_logger();
     }
-    _zmqContext = std::make_unique<zmq::context_t>(1);
+    _zmqContext = std::make_unique<zmq::context_t>(_config.get_transport().ioThreads);
+
+    // Tells subscribers this process's sequence numbers apart from those of
+    // other publishers on the same topic; 0 is left for legacy senders
+    std::random_device random;
+    do {
+        _publisherId = random();
+    } while (_publisherId == 0);
 }
 
 server::~server() {
@@ -63,6 +162,47 @@ void server::start() {
         return;
     }
     
+    // The wakeup pair must exist before the listener starts polling on it.
+    // inproc requires bind-before-connect, so the receiver binds first.
+    const std::string wakeupEndpoint = "inproc://wakeup_" + _serverName + "_" +
+        std::to_string(reinterpret_cast<std::uintptr_t>(this));
+    _wakeupReceiver = zmq::socket_t(*_zmqContext, zmq::socket_type::pair);
+    _wakeupReceiver.set(zmq::sockopt::linger, 0);
+    _wakeupReceiver.bind(wakeupEndpoint);
+    _wakeupSender = zmq::socket_t(*_zmqContext, zmq::socket_type::pair);
+    _wakeupSender.set(zmq::sockopt::linger, 0);
+    _wakeupSender.connect(wakeupEndpoint);
+
+    // Callbacks leave the listener thread only when a pool is configured
+    if (_config.get_dispatch_threads() > 0) {
+        _dispatchPool = std::make_unique<dispatch_pool>(_config.get_dispatch_threads(),
+                                                        _config.get_default_max_queue_depth());
+        for (const auto& ep : _config.get_messaging_endpoints()) {
+            _dispatchPool->set_max_queue_depth(ep.topic, ep.maxQueueDepth);
+        }
+    }
+
+    // Flat per-topic tables, indexed by topic_id
+    _pubRoutes.assign(_config.get_topic_count(), nullptr);
+    _publishSequences.assign(_config.get_topic_count(), 0);
+    _busPublishSequences.clear();
+    _reqSockets.clear();
+    _reqSockets.resize(_config.get_topic_count());
+
+    // Async publishing gets its own sender thread, which owns the PUB sockets
+    if (_config.get_async_publish()) {
+        // Created once and kept until ~server: a publisher that got past the
+        // _running check just before stop() may still be pushing into it
+        if (!_publishQueue) {
+            _publishQueue = std::make_unique<bounded_queue<QueuedPublish>>(_config.get_publish_queue_capacity());
+        }
+        _droppedPublishes = 0;
+        _senderIdle = false;
+        _senderRunning = true;
+        _senderThread = std::thread(&server::_sender_loop, this);
+    }
+
+    _wakeupPending = false;
     _running = true;
     _listenerThread = std::thread(&server::_listener_loop, this);
     LOG_INFO << "[server] Server started" << go;
@@ -75,19 +215,70 @@ void server::stop() {
     _running = false;
     
     // Wake up the listener thread
+    _wakeup();
     if (_listenerThread.joinable()) {
         _listenerThread.join();
     }
+
+    // The sender flushes whatever is still queued before it exits
+    if (_senderThread.joinable()) {
+        _senderRunning = false;
+        _publishSignal.fetch_add(1);
+        _publishSignal.notify_one();
+        _senderThread.join();
+    }
+    // Late pushes land after the sender's last pass; they are dropped, the
+    // queue itself stays for publishers still inside it
+    if (_publishQueue) {
+        while (_publishQueue->try_pop()) {}
+    }
+
+    // Nothing feeds the pool any more; running callbacks finish and queued
+    // ones are dropped, except completions someone waits on: those run here
+    if (_dispatchPool) {
+        auto completions = _dispatchPool->stop();
+        _dispatchPool.reset();
+        for (auto& completion : completions) {
+            try {
+                completion();
+            } catch (const std::exception& e) {
+                LOG_ERR << "[server] Completion threw during stop: " << e.what() << go;
+            }
+        }
+    }
+
+    // Tasks posted after the listener's last pass still run, on this thread:
+    // requests among them fail with nullptr instead of never completing
+    _run_pending_tasks();
     
-    // Clean up sockets properly
-    std::lock_guard<std::mutex> lock(_socketMutex);
+    // The listener thread is gone, so its sockets can be torn down from here
+    _pubRoutes.clear();
+    _openRequesters.clear();
     _pubSockets.clear();
     _subSockets.clear();
+    _subscriptions.clear();
     _reqSockets.clear();
     _repSockets.clear();
-    _reqSocketReady.clear();
-    _requestReplySocketMap.clear();
+    _drainBudgets.clear();
+    _replyRoutes.clear();
+    _replyBatches.clear();
+    _dirtyReplyBatches.clear();
+    _replyRouteDeadlines = {};
+    // Whoever waits on a request still in flight, a future or a suspended
+    // co_request among them, gets nullptr now rather than never
+    auto pending = std::move(_pendingRequests);
     _pendingRequests.clear();
+    _requestDeadlines = {};
+    for (auto& [id, info] : pending) {
+        if (info.callback) info.callback->on_reply(nullptr);
+    }
+    while (_pendingTasks.pop()) {}
+    while (_outboundPublishes.pop()) {}
+    {
+        std::lock_guard<std::mutex> lock(_wakeupMutex);
+        _wakeupSender.close();
+    }
+    _wakeupReceiver.close();
     
     LOG_INFO << "[server] Server stopped" << go;
 }
@@ -97,56 +288,115 @@ void server::publish(std::shared_ptr<curious::net::network_message> msg, const s
         LOG_ERR << "[server] Cannot publish: server not running" << go;
         return;
     }
-    _doPublish(std::move(msg), topic);
+
+    PublishTarget target;
+    target.id = _resolve_route(topic);
+    if (target.id == kInvalidTopicId) return;
+    target.route = &_config.get_route(target.id);
+    if (target.route->topic.back() == '*') {
+        target.busTopic = topic;  // bus routes are shared, so the message names its own topic
+    }
+    _doPublish(std::move(msg), std::move(target));
+}
+
+void server::publish(std::shared_ptr<curious::net::network_message> msg, topic_id topic) {
+    if (!_running) {
+        LOG_ERR << "[server] Cannot publish: server not running" << go;
+        return;
+    }
+
+    PublishTarget target;
+    target.route = _route_for_id(topic);
+    if (target.route == nullptr) return;
+    if (target.route->topic.back() == '*') {
+        // An id names the route, not a topic on it; the pattern itself is no topic
+        LOG_ERR << "[server] Cannot publish to bus route " << target.route->topic
+                << " by id; publish by topic name instead" << go;
+        return;
+    }
+    target.id = topic;
+    _doPublish(std::move(msg), std::move(target));
+}
+
+topic_id server::topic_id_of(const std::string& topic) const {
+    return _config.get_topic_id(topic);
 }
 
 void server::request(std::shared_ptr<curious::net::network_message> req, const std::string& topic, 
-                    std::shared_ptr<listener> callbackListener, void* closure, bool waitForReply) {
+                    std::shared_ptr<listener> callbackListener, void* closure, bool waitForReply,
+                    std::chrono::milliseconds timeout) {
+    // Resolved here so the listener task carries an id, not a topic copy
+    request(std::move(req), _resolve_route(topic), std::move(callbackListener), closure, waitForReply, timeout);
+}
+
+void server::request(std::shared_ptr<curious::net::network_message> req, topic_id topic, 
+                    std::shared_ptr<listener> callbackListener, void* closure, bool waitForReply,
+                    std::chrono::milliseconds timeout) {
     if (!_running) {
         LOG_ERR << "[server] Cannot send request: server not running" << go;
         return;
     }
+    timeout = _effective_timeout(timeout);
     
     if (waitForReply) {
-        // For synchronous requests, use a condition variable to wait
-        std::mutex waitMutex;
-        std::condition_variable waitCondition;
-        std::shared_ptr<curious::net::network_message> response = nullptr;
-        bool replyReceived = false;
+        // For synchronous requests, use a condition variable to wait. The
+        // state is shared with the listener so a reply (or expiry) landing
+        // after we stop waiting never touches a dead stack frame.
+        struct sync_state {
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::shared_ptr<curious::net::network_message> response;
+            bool done = false;
+        };
+        auto state = std::make_shared<sync_state>();
         
         // Create a synchronous callback listener
         auto syncListener = std::make_shared<sync_listener>(
-            [&](std::shared_ptr<curious::net::network_message> reply) {
-                std::lock_guard<std::mutex> lock(waitMutex);
-                response = reply;
-                replyReceived = true;
-                waitCondition.notify_one();
+            [state](std::shared_ptr<curious::net::network_message> reply) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->response = reply;
+                state->done = true;
+                state->condition.notify_one();
             });
         
-        _doRequest(std::move(req), topic, syncListener, closure, waitForReply);
+        _post([this, req = std::move(req), topic, syncListener, closure, timeout]() mutable {
+            _doRequest(std::move(req), topic, syncListener, closure, true, timeout);
+        });
         
-        // Wait for reply with timeout
-        std::unique_lock<std::mutex> lock(waitMutex);
-        if (waitCondition.wait_for(lock, std::chrono::seconds(30), [&] { return replyReceived; })) {
-            if (response && callbackListener) {
-                callbackListener->on_reply(response);
-            } else if (response) {
-                on_reply(response);
-            }
+        // The reactor expires the request at its deadline; the slack only
+        // covers a listener thread that has stopped
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->condition.wait_for(lock, timeout + kSyncWaitSlack, [&] { return state->done; });
+        auto response = std::move(state->response);
+        lock.unlock();
+
+        if (response && callbackListener) {
+            callbackListener->on_reply(response);
+        } else if (response) {
+            on_reply(response);
         } else {
-            LOG_ERR << "[server] Request timed out waiting for reply" << go;
+            LOG_ERR << "[server] Request failed or timed out waiting for reply" << go;
             if (callbackListener) {
                 callbackListener->on_reply(nullptr);
             }
         }
     } else {
-        _doRequest(std::move(req), topic, std::move(callbackListener), closure, waitForReply);
+        _post([this, req = std::move(req), topic, callbackListener = std::move(callbackListener), closure, timeout]() mutable {
+            _doRequest(std::move(req), topic, std::move(callbackListener), closure, false, timeout);
+        });
     }
 }
 
 // Async request with future
 std::future<std::shared_ptr<curious::net::network_message>> 
-server::request_async(std::shared_ptr<curious::net::network_message> req, const std::string& topic) {
+server::request_async(std::shared_ptr<curious::net::network_message> req, const std::string& topic,
+                      std::chrono::milliseconds timeout) {
+    return request_async(std::move(req), _resolve_route(topic), timeout);
+}
+
+std::future<std::shared_ptr<curious::net::network_message>> 
+server::request_async(std::shared_ptr<curious::net::network_message> req, topic_id topic,
+                      std::chrono::milliseconds timeout) {
     auto promise = std::make_shared<std::promise<std::shared_ptr<curious::net::network_message>>>();
     auto future = promise->get_future();
     
@@ -158,14 +408,23 @@ server::request_async(std::shared_ptr<curious::net::network_message> req, const
     
     // Create a callback listener that fulfills the promise
     auto callback = std::make_shared<promise_listener>(promise);
-    _doRequest(std::move(req), topic, callback, nullptr, false);
+    _post([this, req = std::move(req), topic, callback, timeout = _effective_timeout(timeout)]() mutable {
+        _doRequest(std::move(req), topic, callback, nullptr, false, timeout);
+    });
     
     return future;
 }
 
 // Async request with callback
 void server::request_async(std::shared_ptr<curious::net::network_message> req, const std::string& topic,
-                          std::function<void(std::shared_ptr<curious::net::network_message>)> callback) {
+                          std::function<void(std::shared_ptr<curious::net::network_message>)> callback,
+                          std::chrono::milliseconds timeout) {
+    request_async(std::move(req), _resolve_route(topic), std::move(callback), timeout);
+}
+
+void server::request_async(std::shared_ptr<curious::net::network_message> req, topic_id topic,
+                          std::function<void(std::shared_ptr<curious::net::network_message>)> callback,
+                          std::chrono::milliseconds timeout) {
     if (!_running) {
         LOG_ERR << "[server] Cannot send async request: server not running" << go;
         if (callback) {
@@ -175,7 +434,139 @@ void server::request_async(std::shared_ptr<curious::net::network_message> req, c
     }
     
     auto listener = std::make_shared<function_listener>(std::move(callback));
-    _doRequest(std::move(req), topic, listener, nullptr, false);
+    _post([this, req = std::move(req), topic, listener, timeout = _effective_timeout(timeout)]() mutable {
+        _doRequest(std::move(req), topic, listener, nullptr, false, timeout);
+    });
+}
+
+// Streamed reply, one callback per chunk
+void server::request_stream(std::shared_ptr<curious::net::network_message> req, const std::string& topic,
+                            std::function<void(std::shared_ptr<curious::net::network_message>, bool)> callback,
+                            std::chrono::milliseconds timeout) {
+    request_stream(std::move(req), _resolve_route(topic), std::move(callback), timeout);
+}
+
+void server::request_stream(std::shared_ptr<curious::net::network_message> req, topic_id topic,
+                            std::function<void(std::shared_ptr<curious::net::network_message>, bool)> callback,
+                            std::chrono::milliseconds timeout) {
+    if (!_running || !req || !req->is_request()) {
+        LOG_ERR << "[server] Cannot send stream request: " << (_running ? "invalid request" : "server not running") << go;
+        if (callback) {
+            callback(nullptr, true);
+        }
+        return;
+    }
+
+    static_cast<curious::net::request&>(*req).setStreamReply(true);
+    auto listener = std::make_shared<stream_listener>(std::move(callback));
+    _post([this, req = std::move(req), topic, listener, timeout = _effective_timeout(timeout)]() mutable {
+        _doRequest(std::move(req), topic, listener, nullptr, false, timeout);
+    });
+}
+
+// Pipelined batch with one future per element
+std::vector<std::future<std::shared_ptr<curious::net::network_message>>>
+server::request_batch_async(std::vector<std::shared_ptr<curious::net::network_message>> reqs, const std::string& topic,
+                            std::chrono::milliseconds timeout) {
+    return request_batch_async(std::move(reqs), _resolve_route(topic), timeout);
+}
+
+std::vector<std::future<std::shared_ptr<curious::net::network_message>>>
+server::request_batch_async(std::vector<std::shared_ptr<curious::net::network_message>> reqs, topic_id topic,
+                            std::chrono::milliseconds timeout) {
+    std::vector<std::future<std::shared_ptr<curious::net::network_message>>> futures;
+    std::vector<std::shared_ptr<listener>> listeners;
+    futures.reserve(reqs.size());
+    listeners.reserve(reqs.size());
+
+    for (size_t i = 0; i < reqs.size(); ++i) {
+        auto promise = std::make_shared<std::promise<std::shared_ptr<curious::net::network_message>>>();
+        futures.push_back(promise->get_future());
+        if (!_running) {
+            promise->set_exception(std::make_exception_ptr(std::runtime_error("Server not running")));
+            continue;
+        }
+        listeners.push_back(std::make_shared<promise_listener>(std::move(promise)));
+    }
+    if (!_running || reqs.empty()) return futures;
+
+    _post([this, reqs = std::move(reqs), topic, listeners = std::move(listeners),
+           timeout = _effective_timeout(timeout)]() mutable {
+        _doRequestBatch(std::move(reqs), topic, std::move(listeners), timeout);
+    });
+    return futures;
+}
+
+// Pipelined batch with one indexed callback
+void server::request_batch_async(std::vector<std::shared_ptr<curious::net::network_message>> reqs, topic_id topic,
+                                 std::function<void(size_t, std::shared_ptr<curious::net::network_message>)> callback,
+                                 std::chrono::milliseconds timeout) {
+    if (!_running) {
+        LOG_ERR << "[server] Cannot send request batch: server not running" << go;
+        if (callback) {
+            for (size_t i = 0; i < reqs.size(); ++i) callback(i, nullptr);
+        }
+        return;
+    }
+    if (reqs.empty()) return;
+
+    // One shared callback; each element's listener only adds its index
+    auto shared = std::make_shared<std::function<void(size_t, std::shared_ptr<curious::net::network_message>)>>(
+        std::move(callback));
+    std::vector<std::shared_ptr<listener>> listeners;
+    listeners.reserve(reqs.size());
+    for (size_t i = 0; i < reqs.size(); ++i) {
+        listeners.push_back(std::make_shared<function_listener>(
+            [shared, i](std::shared_ptr<curious::net::network_message> resp) {
+                if (*shared) (*shared)(i, std::move(resp));
+            }));
+    }
+
+    _post([this, reqs = std::move(reqs), topic, listeners = std::move(listeners),
+           timeout = _effective_timeout(timeout)]() mutable {
+        _doRequestBatch(std::move(reqs), topic, std::move(listeners), timeout);
+    });
+}
+
+server::request_awaiter server::co_request(std::shared_ptr<curious::net::network_message> req, const std::string& topic,
+                                           std::chrono::milliseconds timeout) {
+    return request_awaiter(*this, std::move(req), _resolve_route(topic), _effective_timeout(timeout));
+}
+
+server::request_awaiter server::co_request(std::shared_ptr<curious::net::network_message> req, topic_id topic,
+                                           std::chrono::milliseconds timeout) {
+    return request_awaiter(*this, std::move(req), topic, _effective_timeout(timeout));
+}
+
+std::chrono::milliseconds server::_effective_timeout(std::chrono::milliseconds timeout) const {
+    return timeout > std::chrono::milliseconds::zero() ? timeout : _config.get_request_timeout();
+}
+
+bool server::request_awaiter::await_suspend(std::coroutine_handle<> awaiting) {
+    if (!_server._running || !_request || !_request->is_request()) {
+        LOG_ERR << "[server] Cannot send request: " << (_server._running ? "invalid request" : "server not running") << go;
+        return false;  // resume right away with a null reply
+    }
+    _awaiting = awaiting;
+
+    // Non-owning: the awaiter outlives the request because the coroutine
+    // frame holding it stays suspended until on_reply resumes it. The
+    // listener thread may resume us before this function returns, so
+    // nothing below the post may touch members.
+    std::shared_ptr<listener> self(std::shared_ptr<listener>(), this);
+    _server._post([srv = &_server, req = std::move(_request), topic = _topic, timeout = _timeout,
+                   self = std::move(self)]() mutable {
+        srv->_doRequest(std::move(req), topic, std::move(self), nullptr, false, timeout);
+    });
+    return true;
+}
+
+std::shared_ptr<curious::net::reply> server::request_awaiter::await_resume() {
+    if (!_response || !_response->is_response()) {
+        return nullptr;
+    }
+    // is_response() covers every type derived from reply
+    return std::static_pointer_cast<curious::net::reply>(std::move(_response));
 }
 
 void server::reply(std::shared_ptr<curious::net::network_message> req, 
@@ -185,7 +576,23 @@ void server::reply(std::shared_ptr<curious::net::network_message> req,
         LOG_ERR << "[server] Cannot reply: server not running " << go;
         return;
     }
-    _doReply(req, resp, topic, closure);
+    _post([this, req = std::move(req), resp = std::move(resp), topic, closure]() {
+        _doReply(req, resp, topic, closure, true);
+    });
+}
+
+void server::reply_chunk(std::shared_ptr<curious::net::network_message> req,
+                         std::shared_ptr<curious::net::network_message> chunk,
+                         const std::string& topic, bool last, void* closure) {
+    if (!_running) {
+        LOG_ERR << "[server] Cannot reply: server not running " << go;
+        return;
+    }
+    // Tasks run in the order they were posted, so chunks from one thread
+    // leave in order
+    _post([this, req = std::move(req), chunk = std::move(chunk), topic, last, closure]() {
+        _doReply(req, chunk, topic, closure, last);
+    });
 }
 
 void server::on_request(std::shared_ptr<curious::net::network_message> req) {
@@ -200,41 +607,211 @@ void server::on_message(std::shared_ptr<curious::net::network_message> msg) {
     LOG_INFO << "[server] [default] Pub/Sub message received" << go;
 }
 
-void server::_doPublish(std::shared_ptr<curious::net::network_message> msg, const std::string& topic) {
-    std::lock_guard<std::mutex> lock(_socketMutex);
-    
+void server::on_message_view(std::shared_ptr<curious::net::message_view> msg) {
+    auto obj = msg->materialize();
+    if (obj->is_request()) {
+        on_request(obj);
+    } else if (obj->is_response()) {
+        on_reply(obj);
+    } else {
+        on_message(obj);
+    }
+}
+
+void server::_doPublish(std::shared_ptr<curious::net::network_message> msg, PublishTarget target) {
     if (!msg) {
         LOG_ERR << "[server] Invalid message object" << go;
         return;
     }
 
-    // Ensure PUB socket exists for the topic
-    if (_pubSockets.find(topic) == _pubSockets.end()) {
+    if (_publishQueue) {
+        _enqueue_publish(std::move(msg), std::move(target));
+        return;
+    }
+
+    // Encode on the caller's thread so publishers serialize in parallel; the
+    // PUB socket itself belongs to the listener thread, which does the send.
+    try {
+        outbound_builder builder(msg->getMsgType());
+        net::FactoryBuilder::toCapnp(builder.get(), *msg);
+        const bool packed = target.route->packed;
+        _outboundPublishes.push({std::move(target), encode_frame(builder.get(), packed), msg->getSequence(), packed});
+    } catch (const std::exception& e) {
+        LOG_ERR << "[server] Failed to publish message: " << e.what() << go;
+        return;
+    }
+    _wakeup();
+}
+
+void server::_enqueue_publish(std::shared_ptr<curious::net::network_message> msg, PublishTarget target) {
+    QueuedPublish item{std::move(msg), std::move(target)};
+
+    while (!_publishQueue->try_push(item)) {
+        const auto policy = _config.get_publish_backpressure();
+        if (policy == PublishBackpressure::Block && _senderRunning) {
+            _wake_sender();
+            std::this_thread::yield();
+            continue;
+        }
+        // Evicting the oldest entry pops it like the sender would; the
+        // sender tolerates losing that race, so retry the push afterwards
+        if (policy == PublishBackpressure::DropOldest && _senderRunning) {
+            if (_publishQueue->try_pop()) {
+                const size_t dropped = ++_droppedPublishes;
+                if ((dropped & (dropped - 1)) == 0) {
+                    LOG_WARN << "[server] Publish queue full, dropped oldest message (" << dropped << " so far)" << go;
+                }
+            }
+            continue;
+        }
+        const size_t dropped = ++_droppedPublishes;
+        if ((dropped & (dropped - 1)) == 0) {
+            LOG_WARN << "[server] Publish queue full, dropped message on topic: " << item.target.topic()
+                     << " (" << dropped << " so far)" << go;
+        }
+        return;
+    }
+
+    // Pairs with the fence in _sender_loop: either the sender sees this
+    // message before sleeping, or we see it idle and wake it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_senderIdle.load(std::memory_order_relaxed)) {
+        _wake_sender();
+    }
+}
+
+void server::_wake_sender() {
+    _publishSignal.fetch_add(1, std::memory_order_release);
+    _publishSignal.notify_one();
+}
+
+void server::_sender_loop() {
+    LOG_INFO << "[server] Publish sender thread started" << go;
+    const size_t batchSize = _config.get_publish_batch_size();
+
+    while (true) {
+        if (_send_publish_batch(batchSize) > 0) continue;
+        if (!_senderRunning) break;
+
+        // Nothing queued: advertise that we are idle, then look once more
+        // before sleeping so a push racing with us is never stranded
+        const uint32_t seen = _publishSignal.load(std::memory_order_acquire);
+        _senderIdle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_publishQueue->empty() && _senderRunning) {
+            _publishSignal.wait(seen, std::memory_order_acquire);
+        }
+        _senderIdle.store(false, std::memory_order_relaxed);
+    }
+
+    LOG_INFO << "[server] Publish sender thread stopped" << go;
+}
+
+size_t server::_send_publish_batch(size_t maxMessages) {
+    size_t sent = 0;
+    while (sent < maxMessages) {
+        auto item = _publishQueue->try_pop();
+        if (!item) break;
+        ++sent;
+
+        // The topic and data frames of one message always go out back to
+        // back, so a batch never interleaves parts of different messages
+        try {
+            zmq::socket_t* socket = _pub_socket(item->target);
+            if (!socket) continue;
+            const std::string& topic = item->target.topic();
+
+            outbound_builder builder(item->msg->getMsgType());
+            net::FactoryBuilder::toCapnp(builder.get(), *item->msg);
+            const bool packed = item->target.route->packed;
+            zmq::message_t dataFrame = encode_frame(builder.get(), packed);
+            zmq::message_t topicFrame(topic.begin(), topic.end());
+
+            socket->send(topicFrame, zmq::send_flags::sndmore);
+            const payload_meta meta{.publisher = _publisherId,
+                                    .sequence = _stamp_sequence(item->target, item->msg->getSequence()),
+                                    .packed = packed};
+            send_payload(*socket, dataFrame, meta, zmq::send_flags::none);
+        } catch (const std::exception& e) {
+            LOG_ERR << "[server] Failed to publish message on topic " << item->target.topic() << ": " << e.what() << go;
+        }
+    }
+    return sent;
+}
+
+zmq::socket_t* server::_pub_socket(const PublishTarget& target) {
+    if (zmq::socket_t* cached = _pubRoutes[target.id]) {
+        return cached;
+    }
+
+    // Topics on a shared bus resolve to the same endpoint and share its
+    // socket; brokered topics share one socket connected to the broker
+    const bool brokered = target.route->viaBroker;
+    const std::string endpoint = brokered ? to_connect_endpoint(_config.get_broker_frontend()) : target.route->endpoint;
+    auto sockIt = _pubSockets.find(endpoint);
+    if (sockIt == _pubSockets.end()) {
         try {
             zmq::socket_t pub(*_zmqContext, zmq::socket_type::pub);
-            std::string endpoint = _config.get_endpoint_for_topic(topic).endpoint;
-            pub.bind(endpoint);
-            _pubSockets[topic] = std::move(pub);
-            LOG_INFO << "[server] Created PUB socket for topic: " << topic << " at " << endpoint << go;
+            _apply_socket_options(pub, target.route);
+            if (brokered) {
+                pub.connect(endpoint);
+            } else {
+                pub.bind(endpoint);
+            }
+            sockIt = _pubSockets.emplace(endpoint, std::move(pub)).first;
+            LOG_INFO << "[server] Created PUB socket for topic: " << target.topic() << " at " << endpoint << go;
         } catch (const zmq::error_t& e) {
-            LOG_ERR << "[server] Failed to create PUB socket for topic " << topic << ": " << e.what() << go;
-            return;
+            LOG_ERR << "[server] Failed to create PUB socket for topic " << target.topic() << ": " << e.what() << go;
+            return nullptr;
         }
     }
+    _pubRoutes[target.id] = &sockIt->second;
+    return &sockIt->second;
+}
 
-    try {
-        capnp::MallocMessageBuilder builder;
-        net::FactoryBuilder::toCapnp(builder, msg);
+uint64_t server::_stamp_sequence(const PublishTarget& target, uint64_t explicitSequence) {
+    // Stamped at send time, on the one thread that sends, so numbers leave
+    // in order even when many threads publish. A sequence the application
+    // set itself (e.g. a catalog version) wins and becomes the new base.
+    uint64_t& last = target.busTopic.empty() ? _publishSequences[target.id] : _busPublishSequences[target.busTopic];
+    last = explicitSequence != 0 ? explicitSequence : last + 1;
+    return last;
+}
 
-        kj::VectorOutputStream vecStream;
-        writeMessage(vecStream, builder);
+topic_id server::_resolve_route(const std::string& topic) const {
+    const topic_id id = _config.find_route_id(topic);
+    if (id == kInvalidTopicId) {
+        LOG_ERR << "[server] No endpoint configured for topic: " << topic << go;
+    }
+    return id;
+}
+
+const messaging_endpoint* server::_route_for_id(topic_id topic) const {
+    if (topic >= _config.get_topic_count()) {
+        // kInvalidTopicId comes from a failed lookup that already logged the name
+        if (topic != kInvalidTopicId) {
+            LOG_ERR << "[server] Unknown topic id: " << topic << go;
+        }
+        return nullptr;
+    }
+    return &_config.get_route(topic);
+}
 
-        auto& socket = _pubSockets[topic];
+void server::_send_publish(OutboundPublish& outbound) {
+    const std::string& topic = outbound.target.topic();
+
+    // Ensure PUB socket exists for the topic
+    zmq::socket_t* socket = _pub_socket(outbound.target);
+    if (!socket) return;
+
+    try {
         zmq::message_t topicFrame(topic.begin(), topic.end());
-        zmq::message_t dataFrame(vecStream.getArray().asChars().begin(), vecStream.getArray().size());
 
-        socket.send(topicFrame, zmq::send_flags::sndmore);
-        socket.send(dataFrame, zmq::send_flags::none);
+        socket->send(topicFrame, zmq::send_flags::sndmore);
+        const payload_meta meta{.publisher = _publisherId,
+                                .sequence = _stamp_sequence(outbound.target, outbound.sequence),
+                                .packed = outbound.packed};
+        send_payload(*socket, outbound.frame, meta, zmq::send_flags::none);
         
         LOG_INFO << "[server] Published message on topic: " << topic << go;
     } catch (const std::exception& e) {
@@ -242,125 +819,356 @@ void server::_doPublish(std::shared_ptr<curious::net::network_message> msg, cons
     }
 }
 
-void server::_doReply(std::shared_ptr<curious::net::network_message> req, std::shared_ptr<curious::net::network_message> resp, const std::string& topic, void* /*closure*/) {
+void server::_doReply(std::shared_ptr<curious::net::network_message> req, std::shared_ptr<curious::net::network_message> resp, const std::string& topic, void* /*closure*/, bool last) {
     if (!req || !resp || !resp->is_response() || !req->is_request()) {
         LOG_ERR << "[server] Invalid request or response objects" << go;
         return;
     }
 
-    auto reqCast = std::dynamic_pointer_cast<curious::net::request>(req);
-    auto respCast = std::dynamic_pointer_cast<curious::net::reply>(resp);
-    if (!reqCast || !respCast) {
-        LOG_ERR << "[server] Failed to cast request/response objects" << go;
-        return;
-    }
+    // is_request()/is_response() cover every derived type, so these casts are safe
+    const auto& reqRef = static_cast<const curious::net::request&>(*req);
+    auto& respRef = static_cast<curious::net::reply&>(*resp);
     
-    respCast->setId(reqCast->getId());
+    respRef.setId(reqRef.getId());
 
-    std::lock_guard<std::mutex> lock(_socketMutex);
-    
-    // Look up the socket from the request pointer
-    auto it = _requestReplySocketMap.find(reqCast.get());
-    if (it == _requestReplySocketMap.end() || it->second == nullptr) {
-        LOG_ERR << "[server] No socket found for the given request" << go;
+    // Look up where the request came from; a second reply to the same
+    // request, or one after the route expired, finds nothing here
+    auto it = _replyRoutes.find(reqRef.getReplyToken());
+    if (it == _replyRoutes.end() || it->second.socket == nullptr) {
+        LOG_ERR << "[server] No reply route for request ID: " << reqRef.getId() << go;
+        return;
+    }
+    auto& route = it->second;
+    if (!last && !route.stream) {
+        // The requester would take the first chunk as the whole answer
+        LOG_ERR << "[server] Request ID " << reqRef.getId() << " did not ask for a streamed reply, dropping chunk" << go;
         return;
     }
 
     try {
         // Serialize and send the response
-        capnp::MallocMessageBuilder builder;
-        net::FactoryBuilder::toCapnp(builder, resp);
-
-        kj::VectorOutputStream vecStream;
-        writeMessage(vecStream, builder);
+        outbound_builder builder(respRef.getMsgType());
+        net::FactoryBuilder::toCapnp(builder.get(), respRef);
+        const auto* endpoint = _config.find_route(topic);
+        const bool packed = endpoint != nullptr && endpoint->packed;
+        zmq::message_t dataFrame = encode_frame(builder.get(), packed);
+        const payload_meta meta{
+            .publisher = _publisherId, .sequence = respRef.getSequence(), .packed = packed, .more = !last};
+
+        if (route.batch != 0) {
+            // Batched: held until the reactor flushes the batch, so replies
+            // finished in the same pass share one multipart send
+            if (auto batch = _replyBatches.find(route.batch); batch != _replyBatches.end()) {
+                batch->second.ready.push_back(std::move(dataFrame));
+                if (!meta.empty()) batch->second.ready.push_back(meta.encode());
+                if (!last) _dirtyReplyBatches.push_back(route.batch);
+            }
+        } else if (!send_envelope(*route.socket, route.envelope, last)) {
+            // Echoing the envelope routes the reply to its peer; that peer is
+            // full or gone. A stream missing a chunk is no use, so its route
+            // goes too and the requester times out.
+            LOG_WARN << "[server] Requester not accepting replies on topic: " << topic
+                     << ", dropping reply for request ID: " << reqRef.getId() << go;
+            _release_reply_route(it);
+            return;
+        } else {
+            send_payload(*route.socket, dataFrame, meta, zmq::send_flags::none);
+            if (last) {
+                LOG_INFO << "[server] Sent reply on topic: " << topic << " for request ID: " << reqRef.getId() << go;
+            }
+        }
 
-        zmq::message_t dataFrame(vecStream.getArray().asChars().begin(), vecStream.getArray().size());
-        it->second->send(dataFrame, zmq::send_flags::none);
-        
-        LOG_INFO << "[server] Sent reply on topic: " << topic << " for request ID: " << reqCast->getId() << go;
+        if (!last) {
+            // A stream stays routable while chunks keep coming; the timeout
+            // only runs out when the replier goes quiet
+            route.deadline = std::chrono::steady_clock::now() + route.timeout;
+            _replyRouteDeadlines.emplace(route.deadline, it->first);
+            return;
+        }
     } catch (const zmq::error_t& err) {
         LOG_ERR << "[server] ZMQ send failed: " << err.what() << go;
+    } catch (const std::exception& e) {
+        LOG_ERR << "[server] Failed to encode reply: " << e.what() << go;
     }
 
-    // Clean up the mapping
-    _requestReplySocketMap.erase(it);
+    // Clean up the route
+    _release_reply_route(it);
+}
+
+void server::_release_reply_route(std::unordered_map<uint64_t, ReplyRoute>::iterator it) {
+    const uint64_t batchId = it->second.batch;
+    _replyRoutes.erase(it);
+    if (batchId == 0) return;
+
+    auto batch = _replyBatches.find(batchId);
+    if (batch == _replyBatches.end()) return;
+    --batch->second.outstanding;
+    _dirtyReplyBatches.push_back(batchId);
+}
+
+void server::_flush_reply_batches() {
+    for (uint64_t batchId : _dirtyReplyBatches) {
+        auto it = _replyBatches.find(batchId);
+        if (it == _replyBatches.end()) continue;  // listed twice, already finished
+        auto& batch = it->second;
+        const bool finished = batch.outstanding == 0;
+
+        if (!batch.ready.empty()) {
+            try {
+                // The last send may consume the envelope; earlier ones copy it
+                if (!send_envelope(*batch.socket, batch.envelope, finished)) {
+                    LOG_WARN << "[server] Requester not accepting replies, dropping " << batch.ready.size()
+                             << " batched replies" << go;
+                } else {
+                    for (size_t i = 0; i < batch.ready.size(); ++i) {
+                        const bool last = i + 1 == batch.ready.size();
+                        batch.socket->send(batch.ready[i], last ? zmq::send_flags::none : zmq::send_flags::sndmore);
+                    }
+                    LOG_INFO << "[server] Sent " << batch.ready.size() << " batched replies" << go;
+                }
+            } catch (const zmq::error_t& err) {
+                LOG_ERR << "[server] ZMQ send failed for reply batch: " << err.what() << go;
+            }
+            batch.ready.clear();
+        }
+
+        if (finished) _replyBatches.erase(it);
+    }
+    _dirtyReplyBatches.clear();
 }
 
-void server::_doRequest(std::shared_ptr<curious::net::network_message> req, const std::string& topic, 
-                       std::shared_ptr<listener> callbackListener, void* closure, bool waitForReply) {
+void server::_doRequest(std::shared_ptr<curious::net::network_message> req, topic_id topicId, 
+                       std::shared_ptr<listener> callbackListener, void* closure, bool waitForReply,
+                       std::chrono::milliseconds timeout) {
+    if (!_running) {
+        if (callbackListener) callbackListener->on_reply(nullptr);
+        return;
+    }
     if (!req || !req->is_request()) {
         LOG_ERR << "[server] Invalid request object" << go;
+        if (callbackListener) callbackListener->on_reply(nullptr);
         return;
     }
-
-    auto reqPtr = std::dynamic_pointer_cast<curious::net::request>(req);
-    if (!reqPtr) {
-        LOG_ERR << "[server] Request is not of type request" << go;
+    const messaging_endpoint* route = _route_for_id(topicId);
+    if (route == nullptr) {
+        if (callbackListener) callbackListener->on_reply(nullptr);
         return;
     }
+    const std::string& topic = route->topic;
+
+    auto& reqRef = static_cast<curious::net::request&>(*req);
 
-    std::unique_lock<std::mutex> lock(_socketMutex);
-    
     // Assign unique request ID
     int id = ++_requestCounter;
-    reqPtr->setId(id);
+    reqRef.setId(id);
 
-    // Create or recreate REQ socket to ensure clean state
-    try {
-        zmq::socket_t sock(*_zmqContext, zmq::socket_type::req);
-        std::string endpoint = _config.get_endpoint_for_topic(topic).endpoint;
-        
-        // Set socket options for better reliability
-        sock.set(zmq::sockopt::linger, 0); // Don't wait on close
-        sock.set(zmq::sockopt::rcvtimeo, 30000); // 30 second receive timeout
-        sock.set(zmq::sockopt::sndtimeo, 5000);  // 5 second send timeout
-        
-        sock.connect(endpoint);
-        _reqSockets[topic] = std::move(sock);
-        _reqSocketReady[topic] = true;
-        
-        LOG_INFO << "[server] Created/Reset REQ socket for topic: " << topic << " at " << endpoint << go;
-    } catch (const zmq::error_t& e) {
-        LOG_ERR << "[server] Failed to create REQ socket for topic " << topic << ": " << e.what() << go;
+    zmq::socket_t* requester = _requester_socket(topicId, *route);
+    if (requester == nullptr) {
+        if (callbackListener) callbackListener->on_reply(nullptr);
         return;
     }
+    auto& socket = *requester;
 
     try {
         // Encode message
-        capnp::MallocMessageBuilder builder;
-        net::FactoryBuilder::toCapnp(builder, req);
+        outbound_builder builder(reqRef.getMsgType());
+        net::FactoryBuilder::toCapnp(builder.get(), reqRef);
 
-        kj::VectorOutputStream vecStream;
-        writeMessage(vecStream, builder);
+        zmq::message_t delimiter;
+        zmq::message_t dataFrame = encode_frame(builder.get(), route->packed);
 
-        auto& socket = _reqSockets[topic];
-        zmq::message_t dataFrame(vecStream.getArray().asChars().begin(), vecStream.getArray().size());
-        
-        socket.send(dataFrame, zmq::send_flags::none);
-        _reqSocketReady[topic] = false; // Mark as waiting for reply
+        // Empty delimiter first, the same envelope a REQ socket would produce.
+        // Never block the listener thread: a full pipe fails the request instead.
+        if (!socket.send(delimiter, zmq::send_flags::sndmore | zmq::send_flags::dontwait)) {
+            LOG_ERR << "[server] Request queue full for topic: " << topic << ", dropping request ID: " << id << go;
+            if (callbackListener) callbackListener->on_reply(nullptr);
+            return;
+        }
+        const bool stream = reqRef.getStreamReply();
+        // A stream's replier keeps its route alive this long between chunks
+        const payload_meta meta{.packed = route->packed,
+                                .stream = stream,
+                                .timeout = stream ? timeout : std::chrono::milliseconds{0}};
+        send_payload(socket, dataFrame, meta, zmq::send_flags::none);
         
         LOG_INFO << "[server] Sent request ID: " << id << " to topic: " << topic << go;
         
         // Store pending request info
-        _pendingRequests[id] = {callbackListener, closure, topic, std::chrono::steady_clock::now()};
+        const Deadline deadline = std::chrono::steady_clock::now() + timeout;
+        _pendingRequests[id] = {std::move(callbackListener), closure, topicId, deadline,
+                                stream ? timeout : std::chrono::milliseconds{0}};
+        _requestDeadlines.emplace(deadline, id);
         
     } catch (const std::exception& e) {
         LOG_ERR << "[server] Failed to send request: " << e.what() << go;
-        _reqSocketReady[topic] = true; // Reset socket state on error
+        if (callbackListener) callbackListener->on_reply(nullptr);
+    }
+}
+
+void server::_doRequestBatch(std::vector<std::shared_ptr<curious::net::network_message>> reqs, topic_id topicId,
+                            std::vector<std::shared_ptr<listener>> listeners, std::chrono::milliseconds timeout) {
+    const auto fail = [&listeners](size_t i) {
+        if (listeners[i]) listeners[i]->on_reply(nullptr);
+    };
+    const auto failAll = [&](const std::vector<size_t>& indices) {
+        for (size_t i : indices) fail(i);
+    };
+
+    const messaging_endpoint* route = _running ? _route_for_id(topicId) : nullptr;
+    if (route == nullptr) {
+        for (size_t i = 0; i < reqs.size(); ++i) fail(i);
+        return;
+    }
+    const std::string& topic = route->topic;
+
+    zmq::socket_t* requester = _requester_socket(topicId, *route);
+    if (requester == nullptr) {
+        for (size_t i = 0; i < reqs.size(); ++i) fail(i);
+        return;
+    }
+
+    // Encode everything first so the whole batch goes out as one multipart
+    // message or not at all; a bad element only fails itself
+    std::vector<zmq::message_t> dataFrames;
+    std::vector<size_t> sent;  // index into reqs of each frame
+    std::vector<int> ids;
+    dataFrames.reserve(reqs.size());
+    for (size_t i = 0; i < reqs.size(); ++i) {
+        if (!reqs[i] || !reqs[i]->is_request()) {
+            LOG_ERR << "[server] Invalid request object in batch for topic: " << topic << go;
+            fail(i);
+            continue;
+        }
+        auto& reqRef = static_cast<curious::net::request&>(*reqs[i]);
+        const int id = ++_requestCounter;
+        reqRef.setId(id);
+        try {
+            outbound_builder builder(reqRef.getMsgType());
+            net::FactoryBuilder::toCapnp(builder.get(), reqRef);
+            dataFrames.push_back(encode_frame(builder.get(), route->packed));
+            sent.push_back(i);
+            ids.push_back(id);
+        } catch (const std::exception& e) {
+            LOG_ERR << "[server] Failed to encode batched request: " << e.what() << go;
+            fail(i);
+        }
+    }
+    if (dataFrames.empty()) return;
+
+    try {
+        zmq::message_t delimiter;
+        if (!requester->send(delimiter, zmq::send_flags::sndmore | zmq::send_flags::dontwait)) {
+            LOG_ERR << "[server] Request queue full for topic: " << topic << ", dropping batch of "
+                    << dataFrames.size() << " requests" << go;
+            failAll(sent);
+            return;
+        }
+        for (size_t f = 0; f < dataFrames.size(); ++f) {
+            const bool last = f + 1 == dataFrames.size();
+            send_payload(*requester, dataFrames[f], payload_meta{.packed = route->packed},
+                         last ? zmq::send_flags::none : zmq::send_flags::sndmore);
+        }
+    } catch (const std::exception& e) {
+        LOG_ERR << "[server] Failed to send request batch: " << e.what() << go;
+        failAll(sent);
+        return;
+    }
+
+    LOG_INFO << "[server] Sent batch of " << dataFrames.size() << " requests to topic: " << topic << go;
+
+    const Deadline deadline = std::chrono::steady_clock::now() + timeout;
+    for (size_t f = 0; f < sent.size(); ++f) {
+        _pendingRequests[ids[f]] = {std::move(listeners[sent[f]]), nullptr, topicId, deadline};
+        _requestDeadlines.emplace(deadline, ids[f]);
+    }
+}
+
+zmq::socket_t* server::_requester_socket(topic_id topicId, const messaging_endpoint& route) {
+    // One persistent DEALER per topic id carries every outstanding request;
+    // replies are matched back to _pendingRequests by request ID.
+    auto& socket = _reqSockets[topicId];
+    if (socket) return &socket;
+
+    try {
+        zmq::socket_t sock(*_zmqContext, zmq::socket_type::dealer);
+        _apply_socket_options(sock, &route);
+        sock.set(zmq::sockopt::linger, 0); // Don't wait on close
+        sock.connect(route.endpoint);
+        socket = std::move(sock);
+        _openRequesters.push_back(topicId);
+
+        LOG_INFO << "[server] Created DEALER socket for topic: " << route.topic << " at " << route.endpoint << go;
+        return &socket;
+    } catch (const zmq::error_t& e) {
+        LOG_ERR << "[server] Failed to create DEALER socket for topic " << route.topic << ": " << e.what() << go;
+        return nullptr;
     }
 }
 
 void server::_listener_loop() {
     LOG_INFO << "[server] Listener thread started" << go;
-    
+
+    enum class SocketRole { Subscriber, Listener, Requester };
+    struct PollEntry {
+        SocketRole role;
+        const std::string* topic;
+        zmq::socket_t* socket;
+        size_t budget;
+        SubscriberSocket* subscriber;
+        topic_id id;
+    };
+    std::vector<zmq::pollitem_t> items;
+    std::vector<PollEntry> entries;
+
     while (_running) {
         try {
-            _handle_subscriber_messages();
-            _handle_incoming_requests();
-            _handle_request_replies();
+            // Clear before draining: a producer that queues after this point
+            // finds the flag down and wakes us, so nothing is left behind
+            _wakeupPending.store(false);
+            _run_pending_tasks();
+            _flush_reply_batches();
+            _flush_outbound_publishes();
+
+            // Rebuild the poll set; slot 0 is always the wakeup socket
+            items.clear();
+            entries.clear();
+            items.push_back({_wakeupReceiver.handle(), 0, ZMQ_POLLIN, 0});
+            for (auto& [endpoint, subscriber] : _subSockets) {
+                items.push_back({subscriber.socket.handle(), 0, ZMQ_POLLIN, 0});
+                entries.push_back({SocketRole::Subscriber, &endpoint, &subscriber.socket, subscriber.drainBudget, &subscriber, kInvalidTopicId});
+            }
+            for (auto& [topic, socket] : _repSockets) {
+                items.push_back({socket.handle(), 0, ZMQ_POLLIN, 0});
+                entries.push_back({SocketRole::Listener, &topic, &socket, _drainBudgets[topic], nullptr, kInvalidTopicId});
+            }
+            for (topic_id id : _openRequesters) {
+                const auto& route = _config.get_route(id);
+                auto& socket = _reqSockets[id];
+                items.push_back({socket.handle(), 0, ZMQ_POLLIN, 0});
+                entries.push_back({SocketRole::Requester, &route.topic, &socket, std::max<size_t>(route.drainBudget, 1), nullptr, id});
+            }
+
+            zmq::poll(items, _next_poll_timeout());
+
+            if (items[0].revents & ZMQ_POLLIN) {
+                zmq::message_t ignored;
+                while (_wakeupReceiver.recv(ignored, zmq::recv_flags::dontwait)) {}
+            }
+
+            for (size_t i = 0; i < entries.size(); ++i) {
+                if (!(items[i + 1].revents & ZMQ_POLLIN)) continue;
+                const auto& entry = entries[i];
+                switch (entry.role) {
+                    case SocketRole::Subscriber: _handle_subscriber_messages(*entry.subscriber, entry.budget); break;
+                    case SocketRole::Listener:   _handle_incoming_requests(*entry.topic, *entry.socket, entry.budget); break;
+                    case SocketRole::Requester:  _handle_request_replies(entry.id, *entry.socket, entry.budget); break;
+                }
+            }
+
             _cleanup_expired_requests();
-            
-            std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Reduced sleep for better responsiveness
+        } catch (const zmq::error_t& e) {
+            if (e.num() == EINTR) continue;
+            LOG_ERR << "[server] ZMQ error in listener loop: " << e.what() << go;
         } catch (const std::exception& e) {
             LOG_ERR << "[server] Error in listener loop: " << e.what() << go;
         }
@@ -369,225 +1177,481 @@ void server::_listener_loop() {
     LOG_INFO << "[server] Listener thread stopped"<< go;
 }
 
-void server::_handle_subscriber_messages() {
-    std::lock_guard<std::mutex> lock(_socketMutex);
-    
-    for (auto& [topic, socket] : _subSockets) {
+void server::_post(std::function<void()> task) {
+    _pendingTasks.push(std::move(task));
+    _wakeup();
+}
+
+void server::_wakeup() {
+    // Someone already poked the listener since it last looked at its queues
+    if (_wakeupPending.exchange(true)) return;
+
+    std::lock_guard<std::mutex> lock(_wakeupMutex);
+    if (!_wakeupSender) return;
+    try {
+        // A full pipe already holds a pending wakeup, so EAGAIN is fine to ignore
+        (void)_wakeupSender.send(zmq::message_t(), zmq::send_flags::dontwait);
+    } catch (const zmq::error_t& e) {
+        LOG_ERR << "[server] Failed to wake listener thread: " << e.what() << go;
+    }
+}
+
+void server::_run_pending_tasks() {
+    while (auto task = _pendingTasks.pop()) {
         try {
-            zmq::message_t topicFrame, dataFrame;
-            if (!socket.recv(topicFrame, zmq::recv_flags::dontwait)) continue;
-            if (!socket.recv(dataFrame, zmq::recv_flags::none)) continue;
+            (*task)();
+        } catch (const std::exception& e) {
+            LOG_ERR << "[server] Error running listener task: " << e.what() << go;
+        }
+    }
+}
 
-            auto obj = _deserialize_message(dataFrame);
-            if (!obj) continue;
+void server::_flush_outbound_publishes() {
+    while (auto outbound = _outboundPublishes.pop()) {
+        _send_publish(*outbound);
+    }
+}
 
-            if (obj->is_request()) {
-                on_request(obj);
-            } else if (obj->is_response()) {
-                on_reply(obj);
+std::chrono::milliseconds server::_next_poll_timeout() const {
+    // _cleanup_expired_requests ran last iteration, so each top is live or
+    // (if answered since) merely makes us wake a little early
+    auto nearest = Deadline::max();
+    if (!_requestDeadlines.empty()) nearest = _requestDeadlines.top().first;
+    if (!_replyRouteDeadlines.empty()) nearest = std::min(nearest, _replyRouteDeadlines.top().first);
+    if (nearest == Deadline::max()) {
+        return std::chrono::milliseconds(-1); // Nothing to expire: block until traffic or wakeup
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (nearest <= now) return std::chrono::milliseconds(0);
+    // Round up so we never wake a hair before the deadline and spin
+    return std::chrono::ceil<std::chrono::milliseconds>(nearest - now);
+}
+
+bool server::_dispatch(const std::string& topic, std::function<void()> callback, bool droppable) {
+    if (!_dispatchPool) {
+        callback();
+        return true;
+    }
+    if (!_dispatchPool->submit(topic, std::move(callback), droppable)) {
+        LOG_WARN << "[server] Dispatch queue full for topic: " << topic << ", dropping callback" << go;
+        return false;
+    }
+    return true;
+}
+
+void server::_handle_subscriber_messages(SubscriberSocket& subscriber, size_t budget) {
+    zmq::socket_t& socket = subscriber.socket;
+
+    // Drain up to the socket's budget; anything left keeps it readable and
+    // is picked up on the next poll, after the other sockets had a turn.
+    for (size_t received = 0; received < budget; ++received) {
+        try {
+            zmq::message_t topicFrame, dataFrame;
+            if (!socket.recv(topicFrame, zmq::recv_flags::dontwait)) return;
+            if (!topicFrame.more() || !socket.recv(dataFrame, zmq::recv_flags::none)) continue;
+
+            // [topic][data] then an optional metadata frame; anything else
+            // past the data is from a newer peer and is skipped
+            payload_meta meta;
+            for (bool more = dataFrame.more(); more;) {
+                zmq::message_t extra;
+                if (!socket.recv(extra, zmq::recv_flags::none)) break;
+                read_meta(extra, meta);
+                more = extra.more();
+            }
+            const uint64_t sequence = meta.sequence;
+
+            // ZeroMQ filters by prefix, so "TOPIC_A" also lets "TOPIC_AB"
+            // through; keep only exact topics and bus patterns we asked for
+            const std::string_view frameTopic(static_cast<const char*>(topicFrame.data()), topicFrame.size());
+            const std::string* topicKey = nullptr;
+            bool views = false;
+            if (auto it = subscriber.topics.find(frameTopic); it != subscriber.topics.end()) {
+                topicKey = &it->first;
+                views = it->second;
             } else {
-                on_message(obj);
+                for (const auto& sub : subscriber.prefixes) {
+                    if (frameTopic.starts_with(sub.prefix)) {
+                        topicKey = &sub.pattern;
+                        views = sub.views;
+                        break;
+                    }
+                }
+            }
+            if (topicKey == nullptr) continue;
+            const std::string& topic = *topicKey;
+            if (sequence != 0) _check_sequence(subscriber, frameTopic, topic, meta.publisher, sequence);
+
+            if (views) {
+                auto view = _deserialize_view(std::move(dataFrame), meta.packed);
+                if (!view) continue;
+                _dispatch(topic, [this, view = std::move(view)]() { on_message_view(view); });
+                continue;
             }
+
+            auto obj = _deserialize_message(std::move(dataFrame), meta.packed);
+            if (!obj) continue;
+            obj->setReceivedSequence(sequence);
+
+            _dispatch(topic, [this, obj = std::move(obj)]() {
+                if (obj->is_request()) {
+                    on_request(obj);
+                } else if (obj->is_response()) {
+                    on_reply(obj);
+                } else {
+                    on_message(obj);
+                }
+            });
         } catch (const std::exception& e) {
             LOG_ERR << "[server] Error handling subscriber message: " << e.what() << go;
         }
     }
 }
 
-void server::_handle_incoming_requests() {
-    std::vector<std::pair<std::shared_ptr<curious::net::request>, zmq::socket_t*>> requestsToHandle;
+void server::_check_sequence(SubscriberSocket& subscriber, std::string_view frameTopic,
+                             const std::string& topicKey, uint32_t publisher, uint64_t sequence) {
+    // Every publishing process counts on its own, so several publishers on
+    // one topic (e.g. behind the broker) are tracked side by side
+    auto topicIt = subscriber.sequences.find(frameTopic);
+    if (topicIt == subscriber.sequences.end()) {
+        topicIt = subscriber.sequences.emplace(std::string(frameTopic), std::unordered_map<uint32_t, uint64_t>{}).first;
+    }
+    auto [it, first] = topicIt->second.try_emplace(publisher, sequence);
+    // First message from this publisher since subscribing: nothing to compare against yet
+    if (first) return;
+    const uint64_t expected = it->second + 1;
+    it->second = sequence;
+    if (sequence == expected) return;
+
+    const size_t gaps = ++_sequenceGaps;
+    LOG_WARN << "[server] Sequence gap on topic: " << frameTopic << " from publisher " << publisher << ", expected "
+             << expected << " but got " << sequence << " (" << gaps << " gaps so far)" << go;
+    _dispatch(topicKey, [this, topic = std::string(frameTopic), expected, sequence]() {
+        on_sequence_gap(topic, expected, sequence);
+    }, false);
+}
+
+void server::on_sequence_gap(const std::string& topic, uint64_t expected, uint64_t received) {
+    _request_snapshot(topic);
+}
+
+void server::_request_snapshot(const std::string& topic) {
+    const messaging_endpoint* route = _config.find_route(topic);
+    if (route == nullptr || route->snapshotTopic.empty()) return;
 
+    auto req = curious::net::FactoryBuilder::createMessage(route->snapshotRequest);
+    if (!req || !req->is_request()) {
+        LOG_ERR << "[server] Snapshot request type for topic " << topic << " is not a request: "
+                << route->snapshotRequest << go;
+        return;
+    }
     {
-        std::lock_guard<std::mutex> lock(_socketMutex);
-        
-        for (auto& [topic, socket] : _repSockets) {
-            try {
-                zmq::message_t dataFrame;
-                auto result = socket.recv(dataFrame, zmq::recv_flags::dontwait);
-                if (!result) continue;
+        std::lock_guard<std::mutex> lock(_resyncMutex);
+        if (!_resyncInFlight.insert(topic).second) return;
+    }
+    req->setTopic(topic);
 
-                auto obj = _deserialize_message(dataFrame);
-                if (!obj || !obj->is_request()) {
-                    // Send error response to maintain REQ/REP state
-                    std::string errorMsg = "Invalid request";
-                    zmq::message_t errorFrame(errorMsg.begin(), errorMsg.end());
-                    socket.send(errorFrame, zmq::send_flags::none);
-                    continue;
+    LOG_INFO << "[server] Requesting snapshot for topic: " << topic << " on " << route->snapshotTopic << go;
+    request_async(req, route->snapshotTopic, [this, topic](std::shared_ptr<curious::net::network_message> resp) {
+        {
+            std::lock_guard<std::mutex> lock(_resyncMutex);
+            _resyncInFlight.erase(topic);
+        }
+        if (!resp) {
+            LOG_ERR << "[server] Snapshot request for topic " << topic << " failed; the next gap retries" << go;
+            return;
+        }
+        on_reply(resp);
+    });
+}
+
+void server::_handle_incoming_requests(const std::string& topic, zmq::socket_t& socket, size_t budget) {
+    std::vector<zmq::message_t> frames;
+    std::vector<std::pair<std::shared_ptr<curious::net::request>, uint64_t>> accepted;
+
+    for (size_t received = 0; received < budget; ++received) {
+        accepted.clear();
+
+        try {
+            // ROUTER hands us [identity][empty delimiter][request], or several
+            // request frames after the delimiter for a batch, each possibly
+            // followed by its metadata frame. The envelope is everything up to
+            // the delimiter; without one, everything before the last request.
+            if (!recv_frames(socket, frames)) return;
+            if (frames.size() < 2) {
+                LOG_ERR << "[server] Dropping request without routing envelope" << go;
+                continue;
+            }
+
+            size_t first = frames.size() - 1;
+            while (first > 0 && is_meta_frame(frames[first])) --first;
+            for (size_t i = 0; i + 1 < frames.size(); ++i) {
+                if (frames[i].size() == 0) {
+                    first = i + 1;
+                    break;
                 }
+            }
+            size_t requestCount = 0;
+            for (size_t i = first; i < frames.size(); ++i) {
+                if (!is_meta_frame(frames[i])) ++requestCount;
+            }
+            const bool batched = requestCount > 1;
+
+            // Replies to a batch go back together: the batch keeps the one
+            // envelope and each element only remembers which batch it is in
+            uint64_t batchId = 0;
+            if (batched) {
+                batchId = ++_replyBatchCounter;
+                auto& batch = _replyBatches[batchId];
+                batch.socket = &socket;
+                batch.envelope.reserve(first);
+                for (size_t i = 0; i < first; ++i) batch.envelope.push_back(std::move(frames[i]));
+            }
 
-                auto reqPtr = std::dynamic_pointer_cast<curious::net::request>(obj);
-                if (!reqPtr) {
-                    std::string errorMsg = "Failed to cast request";
-                    zmq::message_t errorFrame(errorMsg.begin(), errorMsg.end());
-                    socket.send(errorFrame, zmq::send_flags::none);
+            const auto now = std::chrono::steady_clock::now();
+            for (size_t i = first; i < frames.size(); ++i) {
+                if (is_meta_frame(frames[i])) continue;  // read with its request below
+                const payload_meta meta = meta_after(frames, i);
+                auto obj = _deserialize_message(std::move(frames[i]), meta.packed);
+                if (!obj || !obj->is_request()) {
+                    LOG_ERR << "[server] Dropping invalid request" << go;
                     continue;
                 }
 
-                // Save the socket mapping and defer processing
-                _requestReplySocketMap[reqPtr.get()] = &socket;
-                requestsToHandle.emplace_back(reqPtr, &socket);
-
-            } catch (const std::exception& e) {
-                LOG_ERR << "[server] Error handling incoming request: " << e.what() << go;
-                try {
-                    std::string errorMsg = "Server error";
-                    zmq::message_t errorFrame(errorMsg.begin(), errorMsg.end());
-                    socket.send(errorFrame, zmq::send_flags::none);
-                } catch (...) {
-                    LOG_ERR << "[server] Failed to send error response, socket may be corrupted"<< go;
+                // Save the route under a fresh token so reply() can find its way back
+                auto reqPtr = std::static_pointer_cast<curious::net::request>(std::move(obj));
+                const uint64_t token = ++_replyTokenCounter;
+                reqPtr->setReplyToken(token);
+                auto& route = _replyRoutes[token];
+                route.socket = &socket;
+                route.batch = batchId;
+                route.stream = meta.stream;
+                // A stream's route lives as long as its requester waits
+                route.timeout = meta.stream && meta.timeout.count() > 0 ? meta.timeout : _config.get_request_timeout();
+                route.deadline = now + route.timeout;
+                reqPtr->setStreamReply(meta.stream);
+                if (!batched) {
+                    route.envelope.reserve(first);
+                    for (size_t e = 0; e < first; ++e) route.envelope.push_back(std::move(frames[e]));
                 }
+                _replyRouteDeadlines.emplace(route.deadline, token);
+                accepted.emplace_back(std::move(reqPtr), token);
+            }
+
+            if (batched) {
+                _replyBatches[batchId].outstanding = accepted.size();
+                if (accepted.empty()) _replyBatches.erase(batchId);
             }
+        } catch (const std::exception& e) {
+            LOG_ERR << "[server] Error handling incoming request: " << e.what() << go;
         }
-    }
 
-    // Call on_request outside of the mutex lock to avoid deadlock
-    for (const auto& [reqPtr, _] : requestsToHandle) {
-        on_request(reqPtr);
+        for (auto& [reqPtr, token] : accepted) {
+            if (!_dispatch(topic, [this, reqPtr = std::move(reqPtr)]() { on_request(reqPtr); })) {
+                // Never handed to on_request, so never answered
+                if (auto it = _replyRoutes.find(token); it != _replyRoutes.end()) _release_reply_route(it);
+            }
+        }
     }
 }
 
-void server::_handle_request_replies() {
-    std::lock_guard<std::mutex> lock(_socketMutex);
-    
-    for (auto& [topic, socket] : _reqSockets) {
-        // Only try to receive if we're expecting a reply
-        if (_reqSocketReady[topic]) continue;
-        
-        try {
-            zmq::message_t replyData;
-            if (!socket.recv(replyData, zmq::recv_flags::dontwait)) continue;
-
-            // Mark socket as ready for next request
-            _reqSocketReady[topic] = true;
-
-            auto response = _deserialize_message(replyData);
-            if (!response || !response->is_response()) continue;
-
-            auto respPtr = std::dynamic_pointer_cast<curious::net::reply>(response);
-            if (!respPtr) continue;
+void server::_handle_request_replies(topic_id topicId, zmq::socket_t& socket, size_t budget) {
+    const std::string& topic = _config.get_route(topicId).topic;
+    std::vector<zmq::message_t> frames;
 
-            int id = respPtr->getId();
-            LOG_INFO << "[server] Received reply for request ID: " << id << " on topic: " << topic << go;
-            
-            auto it = _pendingRequests.find(id);
-            if (it != _pendingRequests.end()) {
-                auto [callback, closure, reqTopic, timestamp] = it->second;
-                _pendingRequests.erase(it);
-
-                if (callback) {
-                    callback->on_reply(respPtr);
+    for (size_t received = 0; received < budget; ++received) {
+        try {
+            // DEALER hands us [empty delimiter][reply], or [empty][reply]...
+            // when replies to a batch were ready together; each frame carries
+            // its own request ID
+            if (!recv_frames(socket, frames)) return;
+
+            for (size_t i = 1; i < frames.size(); ++i) {
+                if (is_meta_frame(frames[i])) continue;  // read with its reply below
+                const payload_meta meta = meta_after(frames, i);
+                auto response = _deserialize_message(std::move(frames[i]), meta.packed);
+                if (!response || !response->is_response()) continue;
+                response->setReceivedSequence(meta.sequence);
+
+                auto respPtr = std::static_pointer_cast<curious::net::reply>(std::move(response));
+                int id = respPtr->getId();
+                LOG_INFO << "[server] Received reply for request ID: " << id << " on topic: " << topic << go;
+
+                auto it = _pendingRequests.find(id);
+                if (it != _pendingRequests.end() && meta.more && it->second.streamTimeout.count() > 0) {
+                    // A chunk of a streamed reply: the request stays pending
+                    // until the last chunk, which goes through on_reply below
+                    auto& pending = it->second;
+                    pending.deadline = std::chrono::steady_clock::now() + pending.streamTimeout;
+                    _requestDeadlines.emplace(pending.deadline, id);
+
+                    _dispatch(topic, [this, callback = pending.callback, respPtr = std::move(respPtr)]() {
+                        if (callback) {
+                            callback->on_reply_chunk(respPtr);
+                        } else {
+                            on_reply(respPtr);
+                        }
+                    }, false);
+                } else if (it != _pendingRequests.end()) {
+                    auto callback = std::move(it->second.callback);
+                    _pendingRequests.erase(it);
+
+                    _dispatch(topic, [this, callback = std::move(callback), respPtr = std::move(respPtr)]() {
+                        if (callback) {
+                            callback->on_reply(respPtr);
+                        } else {
+                            on_reply(respPtr);
+                        }
+                    }, false);
                 } else {
-                    on_reply(respPtr);
+                    _dispatch(topic, [this, respPtr = std::move(respPtr)]() { on_reply(respPtr); });
                 }
-            } else {
-                on_reply(respPtr);
             }
         } catch (const std::exception& e) {
             LOG_ERR << "[server] Error handling request reply: " << e.what() << go;
-            _reqSocketReady[topic] = true; // Reset on error
         }
     }
 }
 
 void server::_cleanup_expired_requests() {
-    const auto timeout = std::chrono::seconds(30); // 30 second timeout
     const auto now = std::chrono::steady_clock::now();
     
-    std::lock_guard<std::mutex> lock(_socketMutex);
-    
-    for (auto it = _pendingRequests.begin(); it != _pendingRequests.end();) {
-        auto [callback, closure, topic, timestamp] = it->second;
-        if (now - timestamp > timeout) {
-            LOG_ERR << "[server] Request ID " << it->first << " timed out"<< go;
-            
-            // Reset socket state for timed out requests
-            _reqSocketReady[topic] = true;
-            
-            // Notify callback about timeout
-            if (callback) {
-                callback->on_reply(nullptr); // nullptr indicates timeout/error
-            }
-            
-            it = _pendingRequests.erase(it);
-        } else {
-            ++it;
+    // Pop answered entries as they surface and expire due ones; stop at the
+    // first live deadline still in the future
+    while (!_requestDeadlines.empty()) {
+        const auto [deadline, id] = _requestDeadlines.top();
+        auto it = _pendingRequests.find(id);
+        const bool live = it != _pendingRequests.end() && it->second.deadline == deadline;
+        if (live && deadline > now) break;
+        _requestDeadlines.pop();
+        if (!live) continue;
+
+        LOG_ERR << "[server] Request ID " << id << " timed out"<< go;
+        
+        // Notify callback about timeout
+        auto callback = std::move(it->second.callback);
+        const auto& topic = _config.get_route(it->second.topic).topic;
+        _pendingRequests.erase(it);
+        if (callback) {
+            // nullptr indicates timeout/error
+            _dispatch(topic, [callback = std::move(callback)]() { callback->on_reply(nullptr); }, false);
+        }
+    }
+
+    // Clients give up after the configured request timeout by default, so a
+    // route older than that can rarely be answered usefully
+    while (!_replyRouteDeadlines.empty()) {
+        const auto [deadline, token] = _replyRouteDeadlines.top();
+        auto it = _replyRoutes.find(token);
+        const bool live = it != _replyRoutes.end() && it->second.deadline == deadline;
+        if (live && deadline > now) break;
+        _replyRouteDeadlines.pop();
+        if (live) {
+            _release_reply_route(it);
+            LOG_WARN << "[server] Dropping reply route for unanswered request, token: " << token << go;
         }
     }
 }
 
-std::shared_ptr<curious::net::network_message> server::_deserialize_message(const zmq::message_t& frame) {
+std::shared_ptr<curious::net::network_message> server::_deserialize_message(zmq::message_t&& frame, bool packed) {
     try {
-        kj::Array<capnp::word> wordArray = kj::heapArray<capnp::word>(
-            (frame.size() + sizeof(capnp::word) - 1) / sizeof(capnp::word));
-        std::memcpy(wordArray.begin(), frame.data(), frame.size());
-
-        capnp::FlatArrayMessageReader reader(wordArray);
-        return curious::net::FactoryBuilder::fromCapnp(reader);
+        // Reads the frame in place when aligned; the frame only has to outlive
+        // fromCapnp because the factory copies everything into owned objects
+        frame_reader input(std::move(frame), packed);
+        return curious::net::FactoryBuilder::fromCapnp(input.reader());
     } catch (const std::exception& e) {
         LOG_ERR << "[server] Failed to deserialize message: " << e.what() << go;
         return nullptr;
     }
 }
 
+std::shared_ptr<curious::net::message_view> server::_deserialize_view(zmq::message_t&& frame, bool packed) {
+    try {
+        // The view reads the frame lazily, so the frame_reader has to live as
+        // long as the view; the aliasing pointer ties the two lifetimes together
+        auto input = std::make_shared<frame_reader>(std::move(frame), packed);
+        std::shared_ptr<capnp::MessageReader> reader(input, &input->reader());
+        return curious::net::FactoryBuilder::createView(std::move(reader));
+    } catch (const std::exception& e) {
+        LOG_ERR << "[server] Failed to decode message view: " << e.what() << go;
+        return nullptr;
+    }
+}
+
 void server::listen(const std::string& topic) {
-    const auto& endpointInfo = _config.get_endpoint_for_topic(topic);
-    const auto& endpoint = endpointInfo.endpoint;
+    const auto endpointInfo = _config.get_endpoint_for_topic(topic);
 
-    if (endpoint.empty()) {
+    if (endpointInfo.endpoint.empty()) {
         LOG_ERR << "[server] No endpoint configured for topic: " << topic << go;
         return;
     }
     
-    std::lock_guard<std::mutex> lock(_socketMutex);
-    if (_repSockets.find(topic) != _repSockets.end()) {
-        LOG_INFO << "[server] Already listening on topic: " << topic << go;
-        return;
-    }
-    
-    LOG_INFO << "[server] Listening on topic: " << topic << " at endpoint: " << endpoint << go;
-    _activate_endpoint(endpointInfo, ActionType::Listen);
+    _post([this, endpointInfo]() {
+        if (_repSockets.find(endpointInfo.topic) != _repSockets.end()) {
+            LOG_INFO << "[server] Already listening on topic: " << endpointInfo.topic << go;
+            return;
+        }
+
+        LOG_INFO << "[server] Listening on topic: " << endpointInfo.topic << " at endpoint: " << endpointInfo.endpoint << go;
+        _activate_endpoint(endpointInfo, ActionType::Listen);
+    });
 }
 
 void server::subscribe(const std::string& topic) {
-    const auto& endpointInfo = _config.get_endpoint_for_topic(topic);
+    const auto endpointInfo = _config.get_endpoint_for_topic(topic);
     if (endpointInfo.endpoint.empty()) {
         LOG_ERR << "[server] No endpoint configured for topic: " << topic << go;
         return;
     }
     
-    std::lock_guard<std::mutex> lock(_socketMutex);
-    if (_subSockets.find(topic) != _subSockets.end()) {
-        LOG_INFO << "[server] Already subscribed to topic: " << topic << go;
-        return;
-    }
-    
-    LOG_INFO << "[server] Subscribing to topic: " << topic << " at endpoint: " << endpointInfo.endpoint << go;
-    _activate_endpoint(endpointInfo, ActionType::Subscribe);
+    _post([this, endpointInfo]() {
+        if (_subscriptions.find(endpointInfo.topic) != _subscriptions.end()) {
+            LOG_INFO << "[server] Already subscribed to topic: " << endpointInfo.topic << go;
+            return;
+        }
+
+        LOG_INFO << "[server] Subscribing to topic: " << endpointInfo.topic << " at endpoint: " << endpointInfo.endpoint << go;
+        _activate_endpoint(endpointInfo, ActionType::Subscribe);
+    });
+}
+
+void server::unsubscribe(const std::string& topic) {
+    _post([this, topic]() {
+        _remove_subscription(topic);
+    });
 }
 
 void server::_activate_endpoint(messaging_endpoint endpointInfo, ActionType actionType) {
     try {
+        if (actionType == ActionType::Listen) {
+            _drainBudgets[endpointInfo.topic] = std::max<size_t>(endpointInfo.drainBudget, 1);
+        }
+
+        // Brokered topics all arrive over one SUB socket on the broker's backend
+        if (actionType == ActionType::Subscribe && endpointInfo.viaBroker) {
+            const std::string connectEndpoint = to_connect_endpoint(_config.get_broker_backend());
+            _add_subscription(endpointInfo, connectEndpoint);
+            LOG_INFO << "[server] Subscribed (broker) to: " << endpointInfo.topic << " at " << connectEndpoint << go;
+            return;
+        }
+
         switch (endpointInfo.type) {
             case EndpointType::TCP: {
                 if (actionType == ActionType::Listen) {
-                    zmq::socket_t rep(*_zmqContext, zmq::socket_type::rep);
+                    zmq::socket_t router(*_zmqContext, zmq::socket_type::router);
+                    _apply_socket_options(router, &endpointInfo);
                     
                     // Set socket options for better reliability
-                    rep.set(zmq::sockopt::linger, 0);
-                    rep.set(zmq::sockopt::rcvtimeo, -1); // Block indefinitely on receive
+                    router.set(zmq::sockopt::linger, 0);
+                    router.set(zmq::sockopt::router_mandatory, true); // Report replies to vanished peers
                     
-                    rep.bind(endpointInfo.endpoint);
-                    _repSockets[endpointInfo.topic] = std::move(rep);
+                    router.bind(endpointInfo.endpoint);
+                    _repSockets[endpointInfo.topic] = std::move(router);
                     LOG_INFO << "[server] Listening (TCP) on: " << endpointInfo.topic << " at " << endpointInfo.endpoint << go;
                 } else if (actionType == ActionType::Subscribe) {
-                    zmq::socket_t sub(*_zmqContext, zmq::socket_type::sub);
-                    std::string connectEndpoint = endpointInfo.endpoint;
-                    if (connectEndpoint.find("*") != std::string::npos)
-                        connectEndpoint.replace(connectEndpoint.find("*"), 1, "127.0.0.1");
-
-                    sub.connect(connectEndpoint);
-                    sub.set(zmq::sockopt::subscribe, endpointInfo.topic);
-                    _subSockets[endpointInfo.topic] = std::move(sub);
+                    const std::string connectEndpoint = to_connect_endpoint(endpointInfo.endpoint);
+                    _add_subscription(endpointInfo, connectEndpoint);
 
                     LOG_INFO << "[server] Subscribed (TCP) to: " << endpointInfo.topic << " at " << connectEndpoint << go;
                 }
@@ -596,16 +1660,15 @@ void server::_activate_endpoint(messaging_endpoint endpointInfo, ActionType acti
 
             case EndpointType::IPC: {
                 if (actionType == ActionType::Listen) {
-                    zmq::socket_t rep(*_zmqContext, zmq::socket_type::rep);
-                    rep.set(zmq::sockopt::linger, 0);
-                    rep.bind(endpointInfo.endpoint);
-                    _repSockets[endpointInfo.topic] = std::move(rep);
+                    zmq::socket_t router(*_zmqContext, zmq::socket_type::router);
+                    _apply_socket_options(router, &endpointInfo);
+                    router.set(zmq::sockopt::linger, 0);
+                    router.set(zmq::sockopt::router_mandatory, true);
+                    router.bind(endpointInfo.endpoint);
+                    _repSockets[endpointInfo.topic] = std::move(router);
                     LOG_INFO << "[server] Listening (IPC) on: " << endpointInfo.topic << " at " << endpointInfo.endpoint << go;
                 } else if (actionType == ActionType::Subscribe) {
-                    zmq::socket_t sub(*_zmqContext, zmq::socket_type::sub);
-                    sub.connect(endpointInfo.endpoint);
-                    sub.set(zmq::sockopt::subscribe, endpointInfo.topic);
-                    _subSockets[endpointInfo.topic] = std::move(sub);
+                    _add_subscription(endpointInfo, endpointInfo.endpoint);
                     LOG_INFO << "[server] Subscribed (IPC) to: " << endpointInfo.topic << " at " << endpointInfo.endpoint << go;
                 }
                 break;
@@ -621,6 +1684,72 @@ void server::_activate_endpoint(messaging_endpoint endpointInfo, ActionType acti
     }
 }
 
+void server::_apply_socket_options(zmq::socket_t& socket, const messaging_endpoint* route) const {
+    apply_socket_options(socket, _config.get_transport(), route);
+}
+
+void server::_add_subscription(const messaging_endpoint& endpointInfo, const std::string& connectEndpoint) {
+    // Topics on the same endpoint share one SUB socket; each adds its own filter
+    auto [it, created] = _subSockets.try_emplace(connectEndpoint);
+    auto& subscriber = it->second;
+    if (created) {
+        try {
+            subscriber.socket = zmq::socket_t(*_zmqContext, zmq::socket_type::sub);
+            _apply_socket_options(subscriber.socket, &endpointInfo);
+            subscriber.socket.connect(connectEndpoint);
+        } catch (const zmq::error_t&) {
+            _subSockets.erase(it);
+            throw;
+        }
+    }
+
+    const std::string& topic = endpointInfo.topic;
+    const bool pattern = !topic.empty() && topic.back() == '*';
+    const std::string filter = pattern ? topic.substr(0, topic.size() - 1) : topic;
+    subscriber.socket.set(zmq::sockopt::subscribe, filter);
+    if (pattern) {
+        subscriber.prefixes.push_back({filter, topic, endpointInfo.views});
+    } else {
+        subscriber.topics.emplace(topic, endpointInfo.views);
+    }
+    subscriber.drainBudget = std::max<size_t>({subscriber.drainBudget, endpointInfo.drainBudget, 1});
+    _subscriptions.emplace(topic, connectEndpoint);
+}
+
+void server::_remove_subscription(const std::string& topic) {
+    auto subIt = _subscriptions.find(topic);
+    if (subIt == _subscriptions.end()) {
+        LOG_INFO << "[server] Not subscribed to topic: " << topic << go;
+        return;
+    }
+
+    auto sockIt = _subSockets.find(subIt->second);
+    if (sockIt != _subSockets.end()) {
+        auto& subscriber = sockIt->second;
+        const bool pattern = !topic.empty() && topic.back() == '*';
+        const std::string filter = pattern ? topic.substr(0, topic.size() - 1) : topic;
+        try {
+            subscriber.socket.set(zmq::sockopt::unsubscribe, filter);
+        } catch (const zmq::error_t& e) {
+            LOG_ERR << "[server] Failed to unsubscribe from topic " << topic << ": " << e.what() << go;
+        }
+        if (pattern) {
+            std::erase_if(subscriber.prefixes, [&](const auto& sub) { return sub.pattern == topic; });
+            std::erase_if(subscriber.sequences, [&](const auto& entry) { return entry.first.starts_with(filter); });
+        } else {
+            subscriber.topics.erase(topic);
+            subscriber.sequences.erase(topic);
+        }
+        // Last topic on the endpoint: drop the connection too. The poll set is
+        // rebuilt after tasks run, so nothing still points at the socket.
+        if (subscriber.topics.empty() && subscriber.prefixes.empty()) {
+            _subSockets.erase(sockIt);
+        }
+    }
+    _subscriptions.erase(subIt);
+    LOG_INFO << "[server] Unsubscribed from topic: " << topic << go;
+}
+
 void server::_setup_console_logger() {
     try {
         auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
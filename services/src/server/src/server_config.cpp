@@ -1,4 +1,5 @@
 #include <server/server_config.h>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <base/json.h>
@@ -25,14 +26,103 @@ const std::vector<messaging_endpoint>& server_config::get_messaging_endpoints()
     return _messagingEndpoints;
 }
 
-const messaging_endpoint server_config::get_endpoint_for_topic(const std::string& topic) const{
-        for (const auto& ep : _messagingEndpoints) {
-            if (ep.topic == topic) {
-                return ep;
-            }
-        }
+const messaging_endpoint server_config::get_endpoint_for_topic(const std::string& topic) const {
+    const messaging_endpoint* route = find_route(topic);
+    if (route == nullptr) {
         return {}; // Return an empty endpoint if not found
     }
+    messaging_endpoint resolved = *route;
+    resolved.topic = topic;
+    return resolved;
+}
+
+const messaging_endpoint* server_config::find_route(std::string_view topic) const {
+    const topic_id id = find_route_id(topic);
+    return id == kInvalidTopicId ? nullptr : &_messagingEndpoints[id];
+}
+
+topic_id server_config::find_route_id(std::string_view topic) const {
+    if (auto it = _routeIndex.find(topic); it != _routeIndex.end()) {
+        return it->second;
+    }
+    // Buses are few, so checking each prefix beats a trie here
+    for (topic_id id : _busRoutes) {
+        const auto& bus = _messagingEndpoints[id];
+        if (topic.starts_with(std::string_view(bus.topic).substr(0, bus.topic.size() - 1))) {
+            return id;
+        }
+    }
+    return kInvalidTopicId;
+}
+
+topic_id server_config::get_topic_id(std::string_view topic) const {
+    auto it = _routeIndex.find(topic);
+    return it == _routeIndex.end() ? kInvalidTopicId : it->second;
+}
+
+const messaging_endpoint& server_config::get_route(topic_id id) const {
+    return _messagingEndpoints.at(id);
+}
+
+size_t server_config::get_topic_count() const {
+    return _messagingEndpoints.size();
+}
+
+size_t server_config::get_dispatch_threads() const {
+    return _dispatchThreads;
+}
+
+std::chrono::milliseconds server_config::get_request_timeout() const {
+    return _requestTimeout;
+}
+
+size_t server_config::get_default_max_queue_depth() const {
+    return _defaultMaxQueueDepth;
+}
+
+bool server_config::get_async_publish() const {
+    return _asyncPublish;
+}
+
+size_t server_config::get_publish_queue_capacity() const {
+    return _publishQueueCapacity;
+}
+
+size_t server_config::get_publish_batch_size() const {
+    return _publishBatchSize;
+}
+
+PublishBackpressure server_config::get_publish_backpressure() const {
+    return _publishBackpressure;
+}
+
+const transport_options& server_config::get_transport() const {
+    return _transport;
+}
+
+const std::string& server_config::get_cache_endpoint() const {
+    return _cacheEndpoint;
+}
+
+const std::vector<std::string>& server_config::get_cache_topics() const {
+    return _cacheTopics;
+}
+
+const std::string& server_config::get_broker_frontend() const {
+    return _brokerFrontend;
+}
+
+const std::string& server_config::get_broker_backend() const {
+    return _brokerBackend;
+}
+
+int server_config::get_broker_io_threads() const {
+    return _brokerIoThreads;
+}
+
+std::chrono::milliseconds server_config::get_broker_stats_interval() const {
+    return _brokerStatsInterval;
+}
 
 void server_config::_loadFromFile(const std::string& path) {
     std::ifstream config_stream(path);
@@ -52,14 +142,94 @@ void server_config::_loadFromFile(const std::string& path) {
     _logFilePath = logging.value("file_path", "app.log");
     _timestampFormat = logging.value("timestamp_format", "%Y-%m-%d %H:%M:%S");
 
+    // threads == 0 keeps callbacks on the listener thread
+    auto dispatch = config_json.value("dispatch", nlohmann::json::object());
+    _dispatchThreads = dispatch.value("threads", static_cast<size_t>(0));
+    _defaultMaxQueueDepth = dispatch.value("max_queue_depth", static_cast<size_t>(10000));
+    if (_defaultMaxQueueDepth == 0) {
+        _defaultMaxQueueDepth = 1;
+    }
+
+    // mode "async" hands publishes to a sender thread through a bounded queue;
+    // anything else encodes on the caller's thread
+    auto publish = config_json.value("publish", nlohmann::json::object());
+    _asyncPublish = publish.value("mode", "inline") == "async";
+    _publishQueueCapacity = publish.value("queue_capacity", static_cast<size_t>(65536));
+    if (_publishQueueCapacity == 0) {
+        _publishQueueCapacity = 1;
+    }
+    _publishBatchSize = publish.value("batch_size", static_cast<size_t>(256));
+    if (_publishBatchSize == 0) {
+        _publishBatchSize = 1;
+    }
+    const std::string backpressure = publish.value("backpressure", "block");
+    if (backpressure == "drop_oldest") {
+        _publishBackpressure = PublishBackpressure::DropOldest;
+    } else if (backpressure == "drop_newest") {
+        _publishBackpressure = PublishBackpressure::DropNewest;
+    } else {
+        _publishBackpressure = PublishBackpressure::Block;
+    }
+
+    auto transport = config_json.value("transport", nlohmann::json::object());
+    _transport.ioThreads = std::max(transport.value("io_threads", 1), 1);
+    _transport.sndHwm = std::max(transport.value("sndhwm", 1000), 0);
+    _transport.rcvHwm = std::max(transport.value("rcvhwm", 1000), 0);
+    _transport.sndBuf = transport.value("sndbuf", -1);
+    _transport.rcvBuf = transport.value("rcvbuf", -1);
+    _transport.tcpKeepalive = transport.value("tcp_keepalive", -1);
+    _transport.tcpKeepaliveIdle = transport.value("tcp_keepalive_idle", -1);
+    _transport.tcpKeepaliveIntvl = transport.value("tcp_keepalive_intvl", -1);
+    _transport.tcpKeepaliveCnt = transport.value("tcp_keepalive_cnt", -1);
+    _transport.immediate = transport.value("immediate", false);
+    _transport.affinity = transport.value("affinity", static_cast<uint64_t>(0));
+
+    auto cache = config_json.value("cache", nlohmann::json::object());
+    _cacheEndpoint = cache.value("endpoint", "");
+    _cacheTopics = cache.value("topics", std::vector<std::string>{});
+
+    auto broker = config_json.value("broker", nlohmann::json::object());
+    _brokerFrontend = broker.value("frontend", "");
+    _brokerBackend = broker.value("backend", "");
+    _brokerIoThreads = std::max(broker.value("io_threads", std::max(_transport.ioThreads, 2)), 1);
+    _brokerStatsInterval = std::chrono::milliseconds(broker.value("stats_interval_ms", static_cast<int64_t>(10000)));
+
     auto messaging = config_json.value("messaging", nlohmann::json::object());
     auto endpoints = messaging.value("endpoints", nlohmann::json::array());
+    _defaultDrainBudget = messaging.value("drain_budget", static_cast<size_t>(64));
+    if (_defaultDrainBudget == 0) {
+        _defaultDrainBudget = 1;
+    }
+    // Default for requests that don't pass their own timeout, and how long an
+    // unanswered incoming request keeps its reply route
+    _requestTimeout = std::chrono::milliseconds(messaging.value("request_timeout_ms", static_cast<int64_t>(30000)));
+    if (_requestTimeout <= std::chrono::milliseconds::zero()) {
+        _requestTimeout = std::chrono::milliseconds(30000);
+    }
 
     for (const auto& ep : endpoints) {
         messaging_endpoint me;
         me.topic = ep.value("topic", "");
         me.endpoint = ep.value("endpoint", "");
         me.type = EndpointType::UNKNOWN;
+        me.drainBudget = ep.value("drain_budget", _defaultDrainBudget);
+        if (me.drainBudget == 0) {
+            me.drainBudget = _defaultDrainBudget;
+        }
+        me.maxQueueDepth = ep.value("max_queue_depth", _defaultMaxQueueDepth);
+        if (me.maxQueueDepth == 0) {
+            me.maxQueueDepth = _defaultMaxQueueDepth;
+        }
+        me.views = ep.value("views", false);
+        me.snapshotTopic = ep.value("snapshot_topic", "");
+        me.snapshotRequest = ep.value("snapshot_request", "");
+        me.viaBroker = ep.value("broker", false);
+        me.sndHwm = std::max(ep.value("sndhwm", -1), -1);
+        me.rcvHwm = std::max(ep.value("rcvhwm", -1), -1);
+        me.packed = ep.value("compression", "none") == "packed";
+        if (me.viaBroker && me.endpoint.empty()) {
+            me.endpoint = _brokerFrontend;  // pub/sub never uses it; keeps the entry valid
+        }
         if (ep.contains("type")) {
             std::string typeStr = ep["type"];
             if (typeStr == "TCP") {
@@ -73,4 +243,17 @@ void server_config::_loadFromFile(const std::string& path) {
             _messagingEndpoints.push_back(std::move(me));
         }
     }
+
+    // The first entry for a topic wins, as it did with a linear scan;
+    // a duplicate keeps its slot (and id) but is never resolved to
+    for (topic_id id = 0; id < _messagingEndpoints.size(); ++id) {
+        const std::string& topic = _messagingEndpoints[id].topic;
+        if (!_routeIndex.emplace(topic, id).second) continue;
+        if (topic.back() == '*') {
+            _busRoutes.push_back(id);
+        }
+    }
+    std::stable_sort(_busRoutes.begin(), _busRoutes.end(), [this](topic_id a, topic_id b) {
+        return _messagingEndpoints[a].topic.size() > _messagingEndpoints[b].topic.size();
+    });
 }
@@ -0,0 +1,18 @@
+#include <server/socket_options.h>
+
+namespace curious::core {
+
+void apply_socket_options(zmq::socket_t& socket, const transport_options& transport, const messaging_endpoint* route) {
+    socket.set(zmq::sockopt::sndhwm, route != nullptr && route->sndHwm >= 0 ? route->sndHwm : transport.sndHwm);
+    socket.set(zmq::sockopt::rcvhwm, route != nullptr && route->rcvHwm >= 0 ? route->rcvHwm : transport.rcvHwm);
+    if (transport.sndBuf > 0) socket.set(zmq::sockopt::sndbuf, transport.sndBuf);
+    if (transport.rcvBuf > 0) socket.set(zmq::sockopt::rcvbuf, transport.rcvBuf);
+    if (transport.tcpKeepalive >= 0) socket.set(zmq::sockopt::tcp_keepalive, transport.tcpKeepalive);
+    if (transport.tcpKeepaliveIdle >= 0) socket.set(zmq::sockopt::tcp_keepalive_idle, transport.tcpKeepaliveIdle);
+    if (transport.tcpKeepaliveIntvl >= 0) socket.set(zmq::sockopt::tcp_keepalive_intvl, transport.tcpKeepaliveIntvl);
+    if (transport.tcpKeepaliveCnt >= 0) socket.set(zmq::sockopt::tcp_keepalive_cnt, transport.tcpKeepaliveCnt);
+    if (transport.immediate) socket.set(zmq::sockopt::immediate, true);
+    if (transport.affinity != 0) socket.set(zmq::sockopt::affinity, transport.affinity);
+}
+
+}  // namespace curious::core
@@ -0,0 +1,95 @@
+// Batch RequesterServer - sends requests in pipelined batches and compares
+// round trips with one request per send. Pair it with server_test listening
+// on TEST_TOPIC.
+
+#include <server/server.h>
+#include <network/test_request.h>
+#include <network/test_reply.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace curious::core;
+using namespace curious::net;
+
+class BatchRequesterServer : public server {
+private:
+    size_t _batches;
+    size_t _batchSize;
+
+public:
+    BatchRequesterServer(const server_config& config, size_t batches, size_t batchSize)
+        : server(config, "BatchRequesterServer"), _batches(batches), _batchSize(batchSize) {}
+
+    void run_loop() override {
+        const topic_id topic = topic_id_of("TEST_TOPIC");
+
+        const auto batchStart = std::chrono::steady_clock::now();
+        size_t batchedReplies = 0;
+        for (size_t b = 0; b < _batches; ++b) {
+            auto futures = request_batch_async(make_requests(b), topic);
+            for (auto& f : futures) {
+                if (f.get()) ++batchedReplies;
+            }
+        }
+        const double batchSec = seconds_since(batchStart);
+
+        const auto singleStart = std::chrono::steady_clock::now();
+        size_t singleReplies = 0;
+        for (size_t b = 0; b < _batches; ++b) {
+            std::vector<std::future<std::shared_ptr<network_message>>> futures;
+            for (auto& req : make_requests(b)) futures.push_back(request_async(req, topic));
+            for (auto& f : futures) {
+                if (f.get()) ++singleReplies;
+            }
+        }
+        const double singleSec = seconds_since(singleStart);
+
+        const size_t total = _batches * _batchSize;
+        LOG_INFO << "[BatchRequesterServer] batched: " << batchedReplies << "/" << total << " replies in "
+                 << batchSec << " s (" << batchedReplies / batchSec << " req/s)" << go;
+        LOG_INFO << "[BatchRequesterServer] one per send: " << singleReplies << "/" << total << " replies in "
+                 << singleSec << " s (" << singleReplies / singleSec << " req/s)" << go;
+    }
+
+    std::vector<std::shared_ptr<network_message>> make_requests(size_t batch) {
+        std::vector<std::shared_ptr<network_message>> reqs;
+        reqs.reserve(_batchSize);
+        for (size_t i = 0; i < _batchSize; ++i) {
+            auto msg = std::make_shared<test_request>();
+            msg->setAge(static_cast<int>(i));
+            msg->setMessage("Batch " + std::to_string(batch) + " element " + std::to_string(i));
+            msg->setUser("batch_user");
+            reqs.push_back(std::move(msg));
+        }
+        return reqs;
+    }
+
+    static double seconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 2) {
+            std::cerr << "Usage: " << argv[0] << " <config_path> [batches] [batch_size]\n";
+            return 1;
+        }
+
+        server_config config(argv[1]);
+        const size_t batches = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100;
+        const size_t batchSize = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 32;
+        BatchRequesterServer s(config, batches, batchSize);
+
+        LOG_INFO << "[BatchRequesterServer] Starting batch requester server..." << go;
+        s.start();
+        s.stop();
+    } catch (const std::exception& e) {
+        LOG_ERR << "[BatchRequesterServer] Error: " << e.what() << go;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+// Coroutine RequesterServer - drives request chains with co_await, no thread
+// waits on a reply. Pair it with server_test listening on TEST_TOPIC.
+
+#include <server/server.h>
+#include <network/test_request.h>
+#include <network/test_reply.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace curious::core;
+using namespace curious::net;
+
+class CoroutineRequesterServer : public server {
+private:
+    size_t _chains;
+    std::atomic<size_t> _repliesReceived{0};
+    std::atomic<size_t> _chainsFinished{0};
+
+public:
+    CoroutineRequesterServer(const server_config& config, size_t chains)
+        : server(config, "CoroutineRequesterServer"), _chains(chains) {}
+
+    void run_loop() override {
+        const topic_id topic = topic_id_of("TEST_TOPIC");
+        const auto start = std::chrono::steady_clock::now();
+
+        // Every chain runs from this one thread until its first co_await
+        for (size_t chain = 0; chain < _chains; ++chain) {
+            request_chain(topic, static_cast<int>(chain)).detach();
+        }
+
+        while (_chainsFinished < _chains &&
+               std::chrono::steady_clock::now() - start < std::chrono::seconds(40)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        const double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        LOG_INFO << "[CoroutineRequesterServer] " << _chainsFinished << "/" << _chains << " chains finished, "
+                 << _repliesReceived << " replies in " << elapsedSec << " s" << go;
+    }
+
+    // Three dependent requests: each one is sent only after the previous reply
+    task<> request_chain(topic_id topic, int chain) {
+        for (int step = 1; step <= 3; ++step) {
+            auto msg = std::make_shared<test_request>();
+            msg->setAge(30 + step);
+            msg->setMessage("Chain " + std::to_string(chain) + " step " + std::to_string(step));
+            msg->setUser("coroutine_user_" + std::to_string(chain));
+
+            auto reply = co_await co_request(msg, topic);
+            if (!reply) {
+                LOG_ERR << "[CoroutineRequesterServer] Chain " << chain << " step " << step
+                        << " got no reply (timeout or error)" << go;
+                break;
+            }
+            ++_repliesReceived;
+
+            auto testReply = std::dynamic_pointer_cast<test_reply>(reply);
+            if (chain == 0 && testReply) {
+                LOG_INFO << "[CoroutineRequesterServer] Chain 0 step " << step << " reply: "
+                         << testReply->getResponse() << go;
+            }
+        }
+        ++_chainsFinished;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 2) {
+            std::cerr << "Usage: " << argv[0] << " <config_path> [chains]\n";
+            return 1;
+        }
+
+        server_config config(argv[1]);
+        const size_t chains = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+        CoroutineRequesterServer s(config, chains);
+
+        LOG_INFO << "[CoroutineRequesterServer] Starting coroutine requester server..." << go;
+        s.start();
+        s.stop();
+    } catch (const std::exception& e) {
+        LOG_ERR << "[CoroutineRequesterServer] Error: " << e.what() << go;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Packed payload framing test - a packed request can be as short as a
+// metadata frame used to be (8 or 12 bytes). Checks that such payloads are
+// never taken for metadata when several share one message, as in a batch.
+
+#include <server/frame_reader.h>
+#include <server/payload_meta.h>
+#include <messages/network_msg.capnp.h>
+#include <capnp/message.h>
+#include <capnp/serialize-packed.h>
+#include <kj/io.h>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using namespace curious::core;
+
+namespace {
+
+// A snapshot request with only its id set, packed as the server sends it
+zmq::message_t packed_request(int32_t id) {
+    capnp::MallocMessageBuilder builder;
+    builder.initRoot<curious::message::YoutubeVideoSnapshotRequest>().setId(id);
+    kj::VectorOutputStream out;
+    capnp::writePackedMessage(out, builder);
+    return zmq::message_t(out.getArray().begin(), out.getArray().size());
+}
+
+int32_t read_id(zmq::message_t&& frame) {
+    frame_reader input(std::move(frame), true);
+    return input.reader().getRoot<curious::message::YoutubeVideoSnapshotRequest>().getId();
+}
+
+}
+
+int main() {
+    // Each nonzero byte of the id adds one byte to the packed form, so these
+    // cover the sizes that used to read as a sequence frame
+    const std::vector<int32_t> ids = {0x01, 0x0101, 0x010101, 0x01010101};
+    bool shortPayload = false;
+    int failures = 0;
+
+    // [payload][metadata] per request, as a batch puts them after the delimiter
+    std::vector<zmq::message_t> frames;
+    for (int32_t id : ids) {
+        frames.push_back(packed_request(id));
+        const size_t size = frames.back().size();
+        std::cout << "id " << id << ": " << size << " packed bytes" << std::endl;
+        if (size == 8 || size == 12) shortPayload = true;
+        if (is_meta_frame(frames.back())) {
+            std::cerr << "FAIL: packed request of " << size << " bytes taken for metadata" << std::endl;
+            ++failures;
+        }
+        frames.push_back(payload_meta{.sequence = static_cast<uint64_t>(id), .packed = true}.encode());
+    }
+    if (!shortPayload) {
+        std::cerr << "FAIL: no packed request of 8 or 12 bytes to test with" << std::endl;
+        ++failures;
+    }
+
+    size_t next = 0;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (is_meta_frame(frames[i])) continue;
+        const payload_meta meta = meta_after(frames, i);
+        if (next >= ids.size()) {
+            std::cerr << "FAIL: more payloads than were sent" << std::endl;
+            ++failures;
+            break;
+        }
+        const int32_t expected = ids[next++];
+        if (!meta.packed || meta.sequence != static_cast<uint64_t>(expected)) {
+            std::cerr << "FAIL: wrong metadata for request " << expected << std::endl;
+            ++failures;
+        }
+        const int32_t id = read_id(std::move(frames[i]));
+        if (id != expected) {
+            std::cerr << "FAIL: decoded id " << id << ", expected " << expected << std::endl;
+            ++failures;
+        }
+    }
+    if (next != ids.size()) {
+        std::cerr << "FAIL: " << next << " of " << ids.size() << " payloads found" << std::endl;
+        ++failures;
+    }
+
+    std::cout << (failures == 0 ? "ok" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// Publish contention benchmark - 8 application threads publish while the
+// listener thread is busy with a 10 kHz subscriber feed. Run it with
+// "publish": {"mode": "async"} in the config to measure the queued path.
+
+#include <server/server.h>
+#include <network/youtube_video_heartbeat.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace curious::core;
+using namespace curious::net;
+
+namespace {
+constexpr const char* kFeedTopic = "BENCH_FEED";
+constexpr const char* kPublishTopic = "BENCH_PUBLISH";
+constexpr size_t kPublisherThreads = 8;
+constexpr auto kFeedInterval = std::chrono::microseconds(100);  // 10 kHz
+}
+
+class PublishBenchmarkServer : public server {
+private:
+    size_t _messagesPerThread;
+    std::atomic<size_t> _feedReceived{0};
+    std::atomic<bool> _feedRunning{true};
+
+public:
+    PublishBenchmarkServer(const server_config& config, size_t messagesPerThread)
+        : server(config, "PublishBenchmark"), _messagesPerThread(messagesPerThread) {}
+
+    void run_loop() override {
+        subscribe(kFeedTopic);
+        std::thread feed(&PublishBenchmarkServer::feed_loop, this);
+
+        // Let the SUB socket connect and the feed reach steady state
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+        std::vector<std::vector<double>> latencies(kPublisherThreads);
+        std::vector<std::thread> publishers;
+        const size_t feedBefore = _feedReceived;
+        const auto start = std::chrono::steady_clock::now();
+
+        const topic_id publishTopic = topic_id_of(kPublishTopic);
+        for (size_t t = 0; t < kPublisherThreads; ++t) {
+            publishers.emplace_back([this, publishTopic, &samples = latencies[t]]() {
+                samples.reserve(_messagesPerThread);
+                for (size_t i = 0; i < _messagesPerThread; ++i) {
+                    // A fresh message each time: async mode serializes after publish() returns
+                    auto msg = std::make_shared<youtube_video_heartbeat>();
+                    msg->setTopic(kPublishTopic);
+                    msg->setVideosCount(static_cast<int>(i));
+                    const auto before = std::chrono::steady_clock::now();
+                    publish(msg, publishTopic);
+                    samples.push_back(std::chrono::duration<double, std::nano>(
+                        std::chrono::steady_clock::now() - before).count());
+                }
+            });
+        }
+        for (auto& p : publishers) p.join();
+
+        const double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const size_t feedDuring = _feedReceived - feedBefore;
+        _feedRunning = false;
+        feed.join();
+
+        std::vector<double> all;
+        for (const auto& samples : latencies) all.insert(all.end(), samples.begin(), samples.end());
+        std::sort(all.begin(), all.end());
+        double sum = 0;
+        for (double v : all) sum += v;
+
+        LOG_INFO << "[PublishBenchmark] " << all.size() << " publishes from " << kPublisherThreads
+                 << " threads in " << elapsedSec << " s (" << all.size() / elapsedSec << " msg/s)" << go;
+        LOG_INFO << "[PublishBenchmark] publish() latency: mean " << sum / all.size() << " ns, p50 "
+                 << all[all.size() / 2] << " ns, p99 " << all[all.size() * 99 / 100] << " ns" << go;
+        LOG_INFO << "[PublishBenchmark] feed messages received meanwhile: " << feedDuring
+                 << " (" << feedDuring / elapsedSec << " msg/s)" << go;
+        if (_publishQueue) {
+            LOG_INFO << "[PublishBenchmark] async publishes dropped by backpressure: " << _droppedPublishes << go;
+        }
+    }
+
+    void feed_loop() {
+        auto msg = std::make_shared<youtube_video_heartbeat>();
+        msg->setTopic(kFeedTopic);
+        auto next = std::chrono::steady_clock::now();
+        while (_feedRunning) {
+            publish(msg, kFeedTopic);
+            next += kFeedInterval;
+            std::this_thread::sleep_until(next);
+        }
+    }
+
+    void on_message(std::shared_ptr<network_message> msg) override {
+        ++_feedReceived;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 2) {
+            std::cerr << "Usage: " << argv[0] << " <config_path> [messages_per_thread]\n";
+            return 1;
+        }
+
+        server_config config(argv[1]);
+        const size_t messagesPerThread = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+        PublishBenchmarkServer s(config, messagesPerThread);
+        s.start();
+        s.stop();
+    } catch (const std::exception& e) {
+        LOG_ERR << "[PublishBenchmark] Error: " << e.what() << go;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Serialization microbenchmark - virtual toCapnp dispatch vs. the old
+// switch + dynamic_pointer_cast path in FactoryBuilder::toCapnp
+
+#include <network/factory_builder.h>
+#include <base/logger.h>
+#include <capnp/message.h>
+#include <capnp/serialize.h>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+using namespace curious::net;
+
+namespace {
+
+// What FactoryBuilder::toCapnp used to do for every message: switch on the
+// type, then dynamic_pointer_cast (an RTTI walk plus an atomic refcount
+// increment and decrement) before calling the typed toCapnp.
+void legacy_to_capnp(capnp::MessageBuilder& builder, const std::shared_ptr<network_message>& msg) {
+    switch (msg->getMsgType()) {
+        case message_type::youtubeVideoUpdates: {
+            auto root = builder.initRoot<curious::message::YoutubeVideoUpdates>();
+            auto typedMsg = std::dynamic_pointer_cast<youtube_video_updates>(msg);
+            if (!typedMsg) throw std::runtime_error("Failed to cast message to type youtube_video_updates");
+            typedMsg->toCapnp(root);
+            break;
+        }
+        case message_type::youtubeVideoHeartbeat: {
+            auto root = builder.initRoot<curious::message::YoutubeVideoHeartbeat>();
+            auto typedMsg = std::dynamic_pointer_cast<youtube_video_heartbeat>(msg);
+            if (!typedMsg) throw std::runtime_error("Failed to cast message to type youtube_video_heartbeat");
+            typedMsg->toCapnp(root);
+            break;
+        }
+        default: throw std::runtime_error("Unknown message type");
+    }
+}
+
+template <typename Encode>
+double run(const char* name, const std::shared_ptr<network_message>& msg, size_t iterations, Encode encode) {
+    size_t bytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        capnp::MallocMessageBuilder builder;
+        encode(builder, msg);
+        bytes += capnp::computeSerializedSizeInWords(builder);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const double nsPerOp = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    LOG_INFO << "[serialize_benchmark] " << name << ": " << nsPerOp << " ns/op (" << bytes << " words)" << go;
+    return nsPerOp;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    auto heartbeat = std::make_shared<youtube_video_heartbeat>();
+    heartbeat->setTopic("YOUTUBE_VIDEO_HEARTBEAT");
+    heartbeat->setVideosCount(42);
+
+    auto updates = std::make_shared<youtube_video_updates>();
+    updates->setTopic("YOUTUBE_VIDEO_UPDATE");
+    std::vector<youtube_video> videos(5);
+    for (size_t i = 0; i < videos.size(); ++i) {
+        videos[i].setVideoId("video_" + std::to_string(i));
+        videos[i].setTitle("Video Title " + std::to_string(i));
+        videos[i].setThumbnail("http://example.com/thumbnail_" + std::to_string(i) + ".jpg");
+    }
+    updates->setVideos(videos);
+
+    auto legacy = [](capnp::MessageBuilder& b, const std::shared_ptr<network_message>& m) { legacy_to_capnp(b, m); };
+    auto dispatch = [](capnp::MessageBuilder& b, const std::shared_ptr<network_message>& m) { FactoryBuilder::toCapnp(b, *m); };
+
+    // Small messages show the dispatch overhead best; the list message shows
+    // how much of it remains once real field copying dominates
+    for (const auto& msg : {std::static_pointer_cast<network_message>(heartbeat),
+                            std::static_pointer_cast<network_message>(updates)}) {
+        LOG_INFO << "[serialize_benchmark] " << toString(msg->getMsgType()) << ", " << iterations << " iterations" << go;
+        const double before = run("dynamic_pointer_cast", msg, iterations, legacy);
+        const double after = run("virtual toCapnp     ", msg, iterations, dispatch);
+        LOG_INFO << "[serialize_benchmark] speedup: " << before / after << "x" << go;
+    }
+    return 0;
+}
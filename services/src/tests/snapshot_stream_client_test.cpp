@@ -0,0 +1,82 @@
+// Snapshot stream client - asks videosd for its catalog once as a streamed
+// reply and once as a single reply, and compares how soon the first video
+// is usable. Run it next to videosd.
+
+#include <server/server.h>
+#include <network/youtube_video_snapshot_request.h>
+#include <network/youtube_video_snapshot_response.h>
+#include <chrono>
+#include <future>
+#include <iostream>
+
+using namespace curious::core;
+using namespace curious::net;
+
+namespace {
+constexpr const char* kSnapshotTopic = "YOUTUBE_VIDEO_SNAPSHOT";
+
+double ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+class SnapshotStreamClient : public server {
+public:
+    explicit SnapshotStreamClient(const server_config& config) : server(config, "SnapshotStreamClient") {}
+
+    void run_loop() override {
+        const topic_id topic = topic_id_of(kSnapshotTopic);
+
+        // Streamed: chunks arrive in order on the topic's dispatch lane
+        std::promise<void> done;
+        size_t chunks = 0;
+        size_t videos = 0;
+        double firstChunkMs = 0;
+        const auto streamStart = std::chrono::steady_clock::now();
+        request_stream(make_request(), topic, [&](std::shared_ptr<network_message> msg, bool last) {
+            if (auto chunk = std::dynamic_pointer_cast<youtube_video_snapshot_response>(msg)) {
+                if (chunks++ == 0) firstChunkMs = ms_since(streamStart);
+                videos += chunk->getVideos().size();
+            } else if (!msg) {
+                LOG_ERR << "[SnapshotStreamClient] Stream timed out after " << chunks << " chunks" << go;
+            }
+            if (last) done.set_value();
+        });
+        done.get_future().wait();
+        const double streamMs = ms_since(streamStart);
+        LOG_INFO << "[SnapshotStreamClient] streamed: " << videos << " videos in " << chunks << " chunks, first after "
+                 << firstChunkMs << " ms, all after " << streamMs << " ms" << go;
+
+        // Single reply: nothing is usable until the whole list is decoded
+        const auto singleStart = std::chrono::steady_clock::now();
+        auto reply = std::dynamic_pointer_cast<youtube_video_snapshot_response>(
+            request_async(make_request(), topic).get());
+        const double singleMs = ms_since(singleStart);
+        LOG_INFO << "[SnapshotStreamClient] single reply: " << (reply ? reply->getVideos().size() : 0)
+                 << " videos after " << singleMs << " ms" << go;
+    }
+
+    static std::shared_ptr<youtube_video_snapshot_request> make_request() {
+        auto req = std::make_shared<youtube_video_snapshot_request>();
+        req->setTopic(kSnapshotTopic);
+        return req;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 2) {
+            std::cerr << "Usage: " << argv[0] << " <config_path>\n";
+            return 1;
+        }
+
+        server_config config(argv[1]);
+        SnapshotStreamClient s(config);
+        s.start();
+        s.stop();
+    } catch (const std::exception& e) {
+        LOG_ERR << "[SnapshotStreamClient] Error: " << e.what() << go;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Transport tuning benchmark - one PUB/SUB pair over TCP loopback, run once
+// per "transport" knob so the effect of each one shows up on its own.
+//
+// Each case starts from the config's transport section (or the defaults),
+// changes one thing, then streams [topic][payload] messages as fast as PUB
+// accepts them. Reported per case:
+//   msg/s, MB/s  - messages the subscriber got, over first send to last receive
+//   delivered    - share of sent messages that arrived; PUB drops silently at
+//                  the high-water mark, so anything under 100% was lost there
+//
+// What to look for:
+//   io_threads   - helps once one I/O thread saturates (large messages, many
+//                  peers); on one small-message link it mostly adds handoffs
+//   sndhwm/rcvhwm - the main lever on loss: bigger queues absorb bursts at
+//                  the cost of memory (about hwm x message size per peer)
+//   sndbuf/rcvbuf - bigger kernel buffers cut syscalls for large payloads
+//   immediate    - no throughput change on a live link; it stops connecting
+//                  sockets queueing to peers that are not connected yet
+//   tcp_keepalive - no throughput change; it detects dead peers behind NAT
+//   affinity     - pins the connection to one I/O thread, for isolating a
+//                  hot link from the rest
+
+#include <server/server_config.h>
+#include <server/socket_options.h>
+#include <zmq.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct bench_case {
+    std::string name;
+    std::function<void(transport_options&)> tweak;
+};
+
+// Tuned exactly as the server tunes a route's sockets
+void apply(zmq::socket_t& socket, const transport_options& transport, const messaging_endpoint* route) {
+    curious::core::apply_socket_options(socket, transport, route);
+    socket.set(zmq::sockopt::linger, 0);
+}
+
+void run_case(const bench_case& bench, transport_options transport, const messaging_endpoint* route,
+              size_t messages, size_t payloadSize) {
+    bench.tweak(transport);
+
+    zmq::context_t context(transport.ioThreads);
+    zmq::socket_t pub(context, zmq::socket_type::pub);
+    zmq::socket_t sub(context, zmq::socket_type::sub);
+    apply(pub, transport, route);
+    apply(sub, transport, route);
+
+    pub.bind("tcp://127.0.0.1:*");
+    const std::string endpoint = pub.get(zmq::sockopt::last_endpoint);
+    sub.set(zmq::sockopt::subscribe, "BENCH");
+    sub.connect(endpoint);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));  // let the subscription reach PUB
+
+    std::atomic<size_t> received{0};
+    std::chrono::steady_clock::time_point lastReceive;
+    std::thread receiver([&]() {
+        sub.set(zmq::sockopt::rcvtimeo, 500);  // done once the stream stays quiet this long
+        zmq::message_t topic, payload;
+        while (received < messages) {
+            if (!sub.recv(topic, zmq::recv_flags::none)) break;
+            (void)sub.recv(payload, zmq::recv_flags::none);
+            lastReceive = std::chrono::steady_clock::now();
+            ++received;
+        }
+    });
+
+    const std::string topicName = "BENCH";
+    const std::string body(payloadSize, 'x');
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < messages; ++i) {
+        zmq::message_t topic(topicName.begin(), topicName.end());
+        zmq::message_t payload(body.data(), body.size());
+        pub.send(topic, zmq::send_flags::sndmore);
+        pub.send(payload, zmq::send_flags::none);
+    }
+    receiver.join();
+
+    const size_t got = received;
+    const double seconds = got > 0 ? std::chrono::duration<double>(lastReceive - start).count() : 0;
+    const double rate = seconds > 0 ? got / seconds : 0;
+    std::cout << std::left << std::setw(28) << bench.name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(12) << rate << " msg/s" << std::setprecision(1) << std::setw(10)
+              << rate * payloadSize / 1e6 << " MB/s" << std::setw(9) << 100.0 * got / messages << "% delivered\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <config_path> [messages] [payload_bytes] [topic]\n";
+        return 1;
+    }
+
+    try {
+        server_config config(argv[1]);
+        const size_t messages = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+        const size_t payloadSize = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 256;
+
+        const std::vector<bench_case> cases = {
+            {"config as is", [](transport_options&) {}},
+            {"io_threads 2", [](transport_options& t) { t.ioThreads = 2; }},
+            {"io_threads 4", [](transport_options& t) { t.ioThreads = 4; }},
+            {"hwm 100000", [](transport_options& t) { t.sndHwm = t.rcvHwm = 100000; }},
+            {"hwm unbounded", [](transport_options& t) { t.sndHwm = t.rcvHwm = 0; }},
+            {"sndbuf/rcvbuf 4 MiB", [](transport_options& t) { t.sndBuf = t.rcvBuf = 4 << 20; }},
+            {"immediate", [](transport_options& t) { t.immediate = true; }},
+            {"tcp_keepalive 60 s", [](transport_options& t) { t.tcpKeepalive = 1; t.tcpKeepaliveIdle = 60; }},
+            {"io_threads 2, affinity 1", [](transport_options& t) { t.ioThreads = 2; t.affinity = 1; }},
+        };
+
+        // A route's own high-water marks override the transport ones, as in
+        // the server; name a configured topic to measure with its overrides
+        const messaging_endpoint* route = argc > 4 ? config.find_route(argv[4]) : nullptr;
+
+        std::cout << messages << " messages of " << payloadSize << " bytes over TCP loopback\n";
+        for (const auto& bench : cases) {
+            run_case(bench, config.get_transport(), route, messages, payloadSize);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <videosd/video_catalog.h>
+#include <algorithm>
+
+using namespace curious::net;
+
+namespace curious::videosd {
+
+namespace {
+// Received messages carry the publisher's version as their received
+// sequence; ones built locally (tests, replays) only have their own
+uint64_t sequence_of(const network_message& msg) {
+    return msg.getReceivedSequence() != 0 ? msg.getReceivedSequence() : msg.getSequence();
+}
+
+bool same_video(const youtube_video& a, const youtube_video& b) {
+    return a.getVideoId() == b.getVideoId() && a.getTitle() == b.getTitle() &&
+           a.getThumbnail() == b.getThumbnail() && a.getThumbnailMedium() == b.getThumbnailMedium() &&
+           a.getThumbnailHigh() == b.getThumbnailHigh() && a.getThumbnailStandard() == b.getThumbnailStandard() &&
+           a.getThumbnailMaxres() == b.getThumbnailMaxres();
+}
+}
+
+video_catalog::video_catalog() : _current(std::make_shared<const snapshot>()) {}
+
+std::shared_ptr<const video_catalog::snapshot> video_catalog::current() const {
+    std::lock_guard<std::mutex> lock(_currentMutex);
+    return _current;
+}
+
+std::shared_ptr<const video_catalog::snapshot> video_catalog::_swap(std::shared_ptr<const snapshot> next) {
+    std::lock_guard<std::mutex> lock(_currentMutex);
+    std::swap(_current, next);
+    return next;  // released outside the lock
+}
+
+video_catalog::delta video_catalog::apply(std::vector<youtube_video> upserts, const std::vector<std::string>& removals) {
+    std::lock_guard<std::mutex> writer(_writeMutex);
+    const auto base = current();
+
+    delta change;
+    for (auto& video : upserts) {
+        if (is_removal(video)) continue;  // would read as a removal on the wire
+        auto it = base->videos.find(video.getVideoId());
+        if (it != base->videos.end() && same_video(*it->second, video)) continue;
+        change.upserts.push_back(std::make_shared<const youtube_video>(std::move(video)));
+    }
+    for (const auto& id : removals) {
+        if (base->videos.count(id) > 0) change.removals.push_back(id);
+    }
+    if (change.empty()) return change;
+
+    auto next = std::make_shared<snapshot>(*base);
+    next->sequence = base->sequence + 1;
+    for (const auto& video : change.upserts) next->videos[video->getVideoId()] = video;
+    for (const auto& id : change.removals) next->videos.erase(id);
+    change.sequence = next->sequence;
+
+    _swap(std::move(next));
+    return change;
+}
+
+void video_catalog::load(const youtube_video_snapshot_response& response) {
+    std::lock_guard<std::mutex> writer(_writeMutex);
+    auto next = std::make_shared<snapshot>();
+    next->sequence = sequence_of(response);
+    for (auto& video : response.getVideos()) {
+        auto id = video.getVideoId();
+        next->videos[std::move(id)] = std::make_shared<const youtube_video>(std::move(video));
+    }
+    _swap(std::move(next));
+}
+
+void video_catalog::load_chunk(const youtube_video_snapshot_response& chunk, bool last) {
+    std::lock_guard<std::mutex> writer(_writeMutex);
+    if (!_loading || _loading->sequence != sequence_of(chunk)) {
+        _loading = std::make_unique<snapshot>();
+        _loading->sequence = sequence_of(chunk);
+    }
+    for (auto& video : chunk.getVideos()) {
+        auto id = video.getVideoId();
+        _loading->videos[std::move(id)] = std::make_shared<const youtube_video>(std::move(video));
+    }
+    if (!last) return;
+
+    std::shared_ptr<const snapshot> next = std::move(_loading);
+    _swap(std::move(next));
+}
+
+bool video_catalog::merge(const youtube_video_updates& update) {
+    std::lock_guard<std::mutex> writer(_writeMutex);
+    const auto base = current();
+    if (sequence_of(update) <= base->sequence) return true;  // already in the snapshot
+    if (sequence_of(update) != base->sequence + 1) return false;
+
+    auto next = std::make_shared<snapshot>(*base);
+    next->sequence = sequence_of(update);
+    for (auto& video : update.getVideos()) {
+        if (is_removal(video)) {
+            next->videos.erase(video.getVideoId());
+        } else {
+            auto id = video.getVideoId();
+            next->videos[std::move(id)] = std::make_shared<const youtube_video>(std::move(video));
+        }
+    }
+    _swap(std::move(next));
+    return true;
+}
+
+std::shared_ptr<youtube_video_updates> video_catalog::to_updates(const delta& change) {
+    std::vector<youtube_video> videos;
+    videos.reserve(change.upserts.size() + change.removals.size());
+    for (const auto& video : change.upserts) videos.push_back(*video);
+    for (const auto& id : change.removals) {
+        youtube_video removal;
+        removal.setVideoId(id);
+        videos.push_back(std::move(removal));
+    }
+
+    auto update = std::make_shared<youtube_video_updates>();
+    update->setVideos(std::move(videos));
+    update->setSequence(change.sequence);
+    return update;
+}
+
+std::shared_ptr<youtube_video_snapshot_response> video_catalog::to_snapshot_response(const snapshot& state) {
+    std::vector<youtube_video> videos;
+    videos.reserve(state.videos.size());
+    for (const auto& [id, video] : state.videos) videos.push_back(*video);
+
+    auto response = std::make_shared<youtube_video_snapshot_response>();
+    response->setVideos(std::move(videos));
+    response->setSequence(state.sequence);
+    return response;
+}
+
+void video_catalog::to_snapshot_chunks(const snapshot& state, size_t maxVideos, const chunk_sink& emit) {
+    maxVideos = std::max<size_t>(maxVideos, 1);
+    auto it = state.videos.begin();
+    do {
+        std::vector<youtube_video> videos;
+        videos.reserve(std::min(maxVideos, state.videos.size()));
+        for (; it != state.videos.end() && videos.size() < maxVideos; ++it) videos.push_back(*it->second);
+
+        auto chunk = std::make_shared<youtube_video_snapshot_response>();
+        chunk->setVideos(std::move(videos));
+        chunk->setSequence(state.sequence);
+        emit(std::move(chunk), it == state.videos.end());
+    } while (it != state.videos.end());
+}
+
+bool video_catalog::is_removal(const youtube_video& video) {
+    // A catalogued video always has a title; a bare id marks a removal
+    return !video.getVideoId().empty() && video.getTitle().empty() && video.getThumbnail().empty();
+}
+
+}  // namespace curious::videosd
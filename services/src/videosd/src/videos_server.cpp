@@ -2,9 +2,16 @@
 
 using namespace curious::videosd;
 
+namespace {
+constexpr int kNewVideosPerTick = 2;
+constexpr size_t kMaxVideos = 50;
+constexpr size_t kSnapshotChunkVideos = 20;  // per chunk of a streamed snapshot
+}
+
 void video_server::run_loop()  {
     LOG_INFO << "[video_server] Starting publisher server..." << go;
-    std::thread publishThread1(&video_server::publish_loop, this, "YOUTUBE_VIDEO_UPDATE", 60000); // 2 minutes
+    listen(kSnapshotTopic);
+    std::thread publishThread1(&video_server::publish_loop, this, kUpdateTopic, 60000); // 2 minutes
     
     while (is_running()) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -15,34 +22,67 @@ void video_server::run_loop()  {
     if (publishThread1.joinable()) publishThread1.join();
 }
 
+void video_server::on_request(std::shared_ptr<network_message> req) {
+    if (req->getMsgType() != message_type::youtubeVideoSnapshotRequest) {
+        server::on_request(req);
+        return;
+    }
+
+    // The snapshot is immutable, so building the response never blocks the
+    // publish loop; its sequence tells the caller which updates to apply next
+    const auto snapshot = _catalog.current();
+    if (static_cast<const request&>(*req).getStreamReply()) {
+        // Bounded chunks: each is encoded and sent on its own, and the
+        // caller can use the first before the rest are even built
+        size_t chunks = 0;
+        video_catalog::to_snapshot_chunks(*snapshot, kSnapshotChunkVideos,
+                                          [&](std::shared_ptr<youtube_video_snapshot_response> chunk, bool last) {
+            chunk->setTopic(kSnapshotTopic);
+            reply_chunk(req, std::move(chunk), kSnapshotTopic, last);
+            ++chunks;
+        });
+        LOG_INFO << "[video_server] Streamed snapshot of " << snapshot->videos.size() << " videos in " << chunks
+                 << " chunks at sequence " << snapshot->sequence << go;
+        return;
+    }
+
+    auto response = video_catalog::to_snapshot_response(*snapshot);
+    response->setTopic(kSnapshotTopic);
+    reply(req, response, kSnapshotTopic);
+    LOG_INFO << "[video_server] Answered snapshot request with " << snapshot->videos.size()
+             << " videos at sequence " << snapshot->sequence << go;
+}
+
 void video_server::publish_loop(const std::string& topic, int intervalMs) {
     LOG_INFO << "[video_server] Starting publish loop for topic: " << topic << " (interval: " << intervalMs << "ms)" << go;
     int topicCounter = 0;
+    std::deque<std::string> ids;
+    std::vector<youtube_video> upserts;
+    std::vector<std::string> removals;
     
     while (shouldPublish && is_running()) {
         try {
             topicCounter++;
-            
-            if (topic == "YOUTUBE_VIDEO_UPDATE") {
-                // Publish news-style messages
-                auto update = std::make_shared<youtube_video_updates>();
-                update->setMsgType(message_type::youtubeVideoUpdates);
-                update->setTopic(topic);
 
-                std::vector<youtube_video> videos;
-                // Add some dummy video data
-                for (int i = 0; i < 5; ++i) {
-                    youtube_video video;
-                    video.setVideoId("video_" + std::to_string(topicCounter) + "_" + std::to_string(i));
-                    video.setTitle("Video Title " + std::to_string(topicCounter) + " - " + std::to_string(i));
-                    video.setThumbnail("http://example.com/thumbnail_" + std::to_string(i) + ".jpg");
-                    videos.push_back(video);
-                }
-                update->setVideos(videos);
-                
+            upserts.clear();
+            removals.clear();
+            _poll_source(topicCounter, ids, upserts, removals);
+
+            // Only what changed goes out, stamped with the catalog version
+            auto change = _catalog.apply(std::move(upserts), removals);
+            if (!change.empty()) {
+                auto update = video_catalog::to_updates(change);
+                update->setTopic(topic);
                 publish(update, topic);
-                LOG_INFO << "[video_server] Published " << update->getVideos().size() << " videos on topic: " << topic << go;
+                LOG_INFO << "[video_server] Published " << change.upserts.size() << " upserts and "
+                         << change.removals.size() << " removals at sequence " << change.sequence
+                         << " on topic: " << topic << go;
             }
+
+            auto heartbeat = std::make_shared<youtube_video_heartbeat>();
+            heartbeat->setTopic(kHeartbeatTopic);
+            heartbeat->setVideosCount(static_cast<int>(_catalog.current()->videos.size()));
+            publish(heartbeat, kHeartbeatTopic);
         } catch (const std::exception& e) {
             LOG_ERR << "[video_server] Error publishing on " << topic << ": " << e.what() << go;
         }
@@ -51,4 +91,32 @@ void video_server::publish_loop(const std::string& topic, int intervalMs) {
     }
     
     LOG_INFO << "[video_server] Stopped publishing on topic: " << topic << go;
-}
\ No newline at end of file
+}
+
+void video_server::_poll_source(int tick, std::deque<std::string>& ids,
+                                std::vector<youtube_video>& upserts, std::vector<std::string>& removals) {
+    for (int i = 0; i < kNewVideosPerTick; ++i) {
+        youtube_video video;
+        video.setVideoId("video_" + std::to_string(tick) + "_" + std::to_string(i));
+        video.setTitle("Video Title " + std::to_string(tick) + " - " + std::to_string(i));
+        video.setThumbnail("http://example.com/thumbnail_" + std::to_string(i) + ".jpg");
+        ids.push_back(video.getVideoId());
+        upserts.push_back(std::move(video));
+    }
+
+    while (ids.size() > kMaxVideos) {
+        removals.push_back(ids.front());
+        ids.pop_front();
+    }
+
+    // Retitle the oldest surviving video
+    const auto snapshot = _catalog.current();
+    if (!ids.empty()) {
+        if (auto it = snapshot->videos.find(ids.front()); it != snapshot->videos.end()) {
+            youtube_video edited = *it->second;
+            edited.setTitle(edited.getTitle().substr(0, edited.getTitle().find(" (rev ")) +
+                            " (rev " + std::to_string(tick) + ")");
+            upserts.push_back(std::move(edited));
+        }
+    }
+}